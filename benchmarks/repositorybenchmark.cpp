@@ -0,0 +1,338 @@
+// Times every DatabaseManager read and aggregate, plus the StatisticsDataManager
+// load paths, against reproducible synthetic databases of growing size.
+//
+// Usage: repository_benchmark [--output results.json] [--sizes 10000,100000,1000000]
+//        repository_benchmark --records N [--database path]
+//
+// The first form runs the second once per size in a child process, since
+// DatabaseManager can only be initialized once, and writes one JSON document:
+//   {"qt": ..., "sizes": [...], "results": [{"records", "operation", "iterations",
+//    "p50_ms", "p99_ms"}, ...]}
+// Compare two runs by matching results on (records, operation).
+
+#include "database/databaseconnectionmanager.h"
+#include "database/databaseconstants.h"
+#include "database/databaseexecutor.h"
+#include "database/databasemanager.h"
+#include "database/databaseschemamanager.h"
+#include "statistics/components/statisticsdatamanager.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QRandomGenerator>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <algorithm>
+#include <functional>
+
+namespace {
+    const QString DEFAULT_SIZES = "10000,100000,1000000";
+    const int GOAL_COUNT = 25;
+    const int HISTORY_YEARS = 5;
+
+    // Each operation runs until it has MAX_ITERATIONS samples or has used its time budget
+    const int MIN_ITERATIONS = 5;
+    const int MAX_ITERATIONS = 200;
+    const qint64 TIME_BUDGET_MS = 3000;
+
+    const QString GENERATOR_CONNECTION = "benchmark_generator";
+
+    bool exec(QSqlQuery& query)
+    {
+        if (!query.exec()) {
+            qCritical() << "Failed to generate data:" << query.lastError().text();
+            return false;
+        }
+        return true;
+    }
+
+    // Goals, todos and `recordCount` timer records spread over HISTORY_YEARS up to today.
+    // The same record count always produces the same database.
+    bool generateDatabase(const QString& path, int recordCount)
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(DatabaseConstants::DB_DRIVER, GENERATOR_CONNECTION);
+        db.setDatabaseName(path);
+        if (!db.open() ||
+            !DatabaseSchemaManager::createTables(db) ||
+            !DatabaseSchemaManager::createTriggers(db) ||
+            !DatabaseSchemaManager::migrate(db)) {
+            qCritical() << "Failed to create benchmark database:" << db.lastError().text();
+            return false;
+        }
+
+        QRandomGenerator random(static_cast<quint32>(recordCount));
+        const QDate today = QDate::currentDate();
+        const QDate firstDay = today.addYears(-HISTORY_YEARS);
+        const int dayCount = firstDay.daysTo(today) + 1;
+
+        // Biased towards low ids, so a few goals get most of the time like in real use
+        auto pickGoal = [&random]() -> QVariant {
+            if (random.bounded(10) == 0) {
+                return QVariant(QVariant::Int);
+            }
+            return 1 + qMin(random.bounded(GOAL_COUNT), random.bounded(GOAL_COUNT));
+        };
+
+        db.transaction();
+
+        QSqlQuery goalQuery(db);
+        goalQuery.prepare("INSERT INTO goals (title, description, is_completed, priority, color_code, estimated_time) "
+                          "VALUES (?, ?, ?, ?, ?, ?)");
+        for (int i = 1; i <= GOAL_COUNT; ++i) {
+            goalQuery.addBindValue(QString("Goal %1").arg(i));
+            goalQuery.addBindValue(QString("Synthetic goal %1").arg(i));
+            goalQuery.addBindValue(i % 5 == 0);
+            goalQuery.addBindValue(random.bounded(3));
+            goalQuery.addBindValue(ColorConstants::AVAILABLE_COLORS.at(i % ColorConstants::AVAILABLE_COLORS.size()));
+            goalQuery.addBindValue(random.bounded(100, 1000) * 3600);
+            if (!exec(goalQuery)) {
+                return false;
+            }
+        }
+
+        const int todoCount = qMax(200, recordCount / 50);
+        QSqlQuery todoQuery(db);
+        todoQuery.prepare("INSERT INTO todos (title, priority, is_completed, goal_id, start_date, end_date) "
+                          "VALUES (?, ?, ?, ?, ?, ?)");
+        for (int i = 0; i < todoCount; ++i) {
+            const QDate start = firstDay.addDays(random.bounded(dayCount));
+            const QDate end = start.addDays(random.bounded(15));
+            const int shape = random.bounded(10);
+
+            todoQuery.addBindValue(QString("Todo %1").arg(i));
+            todoQuery.addBindValue(random.bounded(3));
+            todoQuery.addBindValue(end < today && random.bounded(5) != 0);
+            todoQuery.addBindValue(random.bounded(10) < 7 ? pickGoal() : QVariant(QVariant::Int));
+            // Mostly ranges, some single-ended, a few undated
+            todoQuery.addBindValue(shape == 9 || shape == 8 ? QVariant(QVariant::Date) : QVariant(start));
+            todoQuery.addBindValue(shape == 9 || shape == 7 ? QVariant(QVariant::Date) : QVariant(end));
+            if (!exec(todoQuery)) {
+                return false;
+            }
+        }
+
+        // Chronological, so ids grow with start time as they do when recorded live
+        QSqlQuery recordQuery(db);
+        recordQuery.prepare("INSERT INTO timer_records (goal_id, start_time, end_time, duration_seconds) "
+                            "VALUES (?, ?, ?, ?)");
+        for (int i = 0; i < recordCount; ++i) {
+            const QDate day = firstDay.addDays(static_cast<qint64>(i) * dayCount / recordCount);
+            const qint64 start = QDateTime(day, QTime(8, 0)).toSecsSinceEpoch() + random.bounded(14 * 3600);
+
+            // Mostly pomodoros, some free-form sessions
+            const int kind = random.bounded(10);
+            const int duration = kind < 6 ? 25 * 60 : kind < 8 ? 50 * 60 : random.bounded(5, 90) * 60;
+
+            recordQuery.addBindValue(pickGoal());
+            recordQuery.addBindValue(start);
+            recordQuery.addBindValue(start + duration);
+            recordQuery.addBindValue(duration);
+            if (!exec(recordQuery)) {
+                return false;
+            }
+        }
+
+        const bool committed = db.commit();
+        db.close();
+        return committed;
+    }
+
+    struct Measurement {
+        QString operation;
+        int iterations = 0;
+        double p50Ms = 0.0;
+        double p99Ms = 0.0;
+    };
+
+    Measurement measure(const QString& operation, const std::function<void()>& run)
+    {
+        QList<double> samples;
+        QElapsedTimer budget;
+        budget.start();
+
+        while (samples.size() < MAX_ITERATIONS &&
+               (samples.size() < MIN_ITERATIONS || budget.elapsed() < TIME_BUDGET_MS)) {
+            QElapsedTimer timer;
+            timer.start();
+            run();
+            samples << timer.nsecsElapsed() / 1e6;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        auto at = [&samples](double fraction) {
+            return samples.at(qMin(static_cast<int>(samples.size() * fraction), samples.size() - 1));
+        };
+
+        return {operation, samples.size(), at(0.50), at(0.99)};
+    }
+
+    // Child mode: one database, one process
+    int runSize(int recordCount, QString databasePath)
+    {
+        QTemporaryDir dir;
+        if (databasePath.isEmpty()) {
+            databasePath = dir.filePath(DatabaseConstants::DB_NAME);
+        }
+
+        if (!QFile::exists(databasePath) && !generateDatabase(databasePath, recordCount)) {
+            return 1;
+        }
+        QSqlDatabase::removeDatabase(GENERATOR_CONNECTION);
+
+        DatabaseConnectionManager::instance().setDatabasePath(databasePath);
+        auto& db = DatabaseManager::instance();
+        if (!db.initialize()) {
+            qCritical() << "Failed to initialize DatabaseManager";
+            return 1;
+        }
+
+        const QDate today = QDate::currentDate();
+        const QDate weekStart = today.addDays(1 - today.dayOfWeek());
+        const QDate monthStart = QDate(today.year(), today.month(), 1);
+        const QDateTime now = QDateTime::currentDateTime();
+        const int goalId = 1;
+        const int recordId = recordCount / 2;
+        const int todoId = 1;
+
+        QList<Measurement> results;
+
+        // Timer records
+        results << measure("getTimerRecord", [&] { db.getTimerRecord(recordId); });
+        results << measure("getTimerRecords(day)", [&] { db.getTimerRecords(today.startOfDay(), now); });
+        results << measure("getTimerRecords(week)", [&] { db.getTimerRecords(weekStart.startOfDay(), now); });
+        results << measure("getTimerRecords(month)", [&] { db.getTimerRecords(monthStart.startOfDay(), now); });
+        results << measure("getTimerRecords(year)", [&] { db.getTimerRecords(now.addYears(-1), now); });
+
+        // Goals
+        results << measure("getGoal", [&] { db.getGoal(goalId); });
+        results << measure("getAllGoals", [&] { db.getAllGoals(true); });
+        results << measure("getAllGoals(pending)", [&] { db.getAllGoals(false); });
+        results << measure("getGoalColor", [&] { db.getGoalColor(goalId); });
+
+        // Aggregates
+        results << measure("getGoalTimeSpent", [&] { db.getGoalTimeSpent(goalId); });
+        results << measure("getGoalTimeSpentInPeriod(month)", [&] { db.getGoalTimeSpentInPeriod(goalId, monthStart, today); });
+        results << measure("getTimePerGoal", [&] { db.getTimePerGoal(); });
+        results << measure("getTimePerGoalInPeriod(week)", [&] { db.getTimePerGoalInPeriod(weekStart, today); });
+        results << measure("getTimePerGoalInPeriod(year)", [&] { db.getTimePerGoalInPeriod(today.addYears(-1), today); });
+
+        // Todos
+        results << measure("getTodo", [&] { db.getTodo(todoId); });
+        results << measure("getAllTodos", [&] { db.getAllTodos(true); });
+        results << measure("getAllTodos(pending)", [&] { db.getAllTodos(false); });
+        results << measure("getTodosByDateRange(week)", [&] { db.getTodosByDateRange(weekStart, today); });
+        results << measure("getTodosByDateRange(month,pending)", [&] { db.getTodosByDateRange(monthStart, today, false); });
+
+        // Statistics: the refresh is asynchronous, so wait for its signal
+        StatisticsDataManager statistics;
+        results << measure("StatisticsDataManager::refreshFromDatabase", [&] {
+            QEventLoop loop;
+            QObject::connect(&statistics, &StatisticsDataManager::dataRefreshed, &loop, &QEventLoop::quit);
+            statistics.refreshFromDatabase();
+            loop.exec();
+        });
+        for (StatisticsRangeType rangeType : {StatisticsRangeType::Daily, StatisticsRangeType::Weekly,
+                                              StatisticsRangeType::Monthly, StatisticsRangeType::Yearly}) {
+            // Goal data is emitted last
+            const QString name = StatisticsPeriod::rangeTypeName(rangeType).toLower();
+            results << measure(QString("StatisticsDataManager::loadStatistics(%1)").arg(name), [&] {
+                QEventLoop loop;
+                QObject::connect(&statistics, &StatisticsDataManager::goalDataLoaded, &loop, &QEventLoop::quit);
+                statistics.loadStatistics(StatisticsPeriod::containing(rangeType, today));
+                loop.exec();
+            });
+        }
+
+        QJsonArray array;
+        for (const Measurement& result : results) {
+            array.append(QJsonObject{
+                {"records", recordCount},
+                {"operation", result.operation},
+                {"iterations", result.iterations},
+                {"p50_ms", result.p50Ms},
+                {"p99_ms", result.p99Ms},
+            });
+        }
+
+        QTextStream(stdout) << QJsonDocument(array).toJson(QJsonDocument::Compact) << "\n";
+
+        // Never reaches aboutToQuit, which normally stops the worker
+        DatabaseExecutor::instance().shutdown();
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Statistics code paths pull in widgets headers; no window is ever shown
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption({"records", "Benchmark a single database with <count> timer records.", "count"});
+    parser.addOption({"database", "Reuse or keep the generated database at <path>.", "path"});
+    parser.addOption({"sizes", "Comma separated timer record counts.", "counts", DEFAULT_SIZES});
+    parser.addOption({"output", "Write the JSON report to <file> instead of stdout.", "file"});
+    parser.process(app);
+
+    if (parser.isSet("records")) {
+        return runSize(parser.value("records").toInt(), parser.value("database"));
+    }
+
+    QJsonArray sizes;
+    QJsonArray results;
+    QTextStream err(stderr);
+
+    for (const QString& size : parser.value("sizes").split(',')) {
+        if (size.trimmed().isEmpty()) {
+            continue;
+        }
+
+        err << "Benchmarking " << size << " timer records...\n";
+        err.flush();
+
+        QProcess child;
+        child.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        child.start(QCoreApplication::applicationFilePath(), {"--records", size});
+        if (!child.waitForFinished(-1) || child.exitCode() != 0) {
+            err << "Run with " << size << " records failed\n";
+            return 1;
+        }
+
+        sizes.append(size.toInt());
+        const QJsonArray childResults = QJsonDocument::fromJson(child.readAllStandardOutput()).array();
+        for (const QJsonValue& result : childResults) {
+            results.append(result);
+        }
+    }
+
+    const QByteArray report = QJsonDocument(QJsonObject{
+        {"qt", QString(qVersion())},
+        {"timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+        {"sizes", sizes},
+        {"results", results},
+    }).toJson();
+
+    if (parser.isSet("output")) {
+        QFile file(parser.value("output"));
+        if (!file.open(QIODevice::WriteOnly)) {
+            err << "Cannot write " << parser.value("output") << "\n";
+            return 1;
+        }
+        file.write(report);
+    } else {
+        QTextStream(stdout) << report;
+    }
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+// Compares timer_records aggregate latency between the DATETIME text layout
+// (schema version 2) and the epoch seconds layout introduced by migration 3.
+//
+// Usage: timer_storage_benchmark [row count, default 1000000]
+
+#include "database/databaseconstants.h"
+#include "database/databaseschemamanager.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <algorithm>
+#include <functional>
+
+namespace {
+    const int GOAL_COUNT = 20;
+    const int DEFAULT_ROW_COUNT = 1000000;
+    const int REPETITIONS = 15;
+
+    // Queries as they were before migration 3
+    const QString LEGACY_SUM_GOAL_TIME =
+        "SELECT SUM(strftime('%s', end_time) - strftime('%s', start_time)) "
+        "FROM timer_records WHERE goal_id = ?";
+
+    const QString LEGACY_SUM_GOAL_TIME_IN_PERIOD =
+        "SELECT SUM(CAST((julianday(end_time) - julianday(start_time)) * 86400 AS INTEGER)) "
+        "FROM timer_records WHERE goal_id = ? AND start_time >= ? AND start_time < ?";
+
+    const QString LEGACY_SELECT_TIMER_RECORDS_IN_RANGE =
+        "SELECT * FROM timer_records WHERE start_time <= ? AND end_time >= ? "
+        "ORDER BY start_time DESC";
+
+    struct Result {
+        QString name;
+        double legacyMs = 0.0;
+        double epochMs = 0.0;
+    };
+
+    bool exec(QSqlDatabase& db, const QString& sql)
+    {
+        QSqlQuery query(db);
+        if (!query.exec(sql)) {
+            qCritical() << "Failed to execute" << sql << ":" << query.lastError().text();
+            return false;
+        }
+        return true;
+    }
+
+    double medianMs(const std::function<void()>& run)
+    {
+        QList<double> samples;
+        for (int i = 0; i < REPETITIONS; ++i) {
+            QElapsedTimer timer;
+            timer.start();
+            run();
+            samples << timer.nsecsElapsed() / 1e6;
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples.at(samples.size() / 2);
+    }
+
+    // Fills a version 2 database the same way TimerRepository::add used to
+    bool populateLegacyDatabase(QSqlDatabase& db, int rowCount)
+    {
+        if (!DatabaseSchemaManager::createTables(db) ||
+            !exec(db, DatabaseQueries::CREATE_TIMER_RECORDS_START_INDEX) ||
+            !exec(db, DatabaseQueries::CREATE_TIMER_RECORDS_GOAL_START_INDEX) ||
+            !exec(db, DatabaseQueries::CREATE_TODOS_DATE_RANGE_INDEX) ||
+            !exec(db, "PRAGMA user_version = 2")) {
+            return false;
+        }
+
+        db.transaction();
+
+        QSqlQuery goalQuery(db);
+        goalQuery.prepare("INSERT INTO goals (title) VALUES (?)");
+        for (int i = 1; i <= GOAL_COUNT; ++i) {
+            goalQuery.addBindValue(QString("Goal %1").arg(i));
+            goalQuery.exec();
+        }
+
+        // Roughly five years of sessions ending now
+        QRandomGenerator random(42);
+        const QDateTime now = QDateTime::currentDateTime();
+        const int span = 5 * 365 * DatabaseConstants::SECONDS_PER_DAY;
+
+        QSqlQuery query(db);
+        query.prepare("INSERT INTO timer_records (goal_id, start_time, end_time) VALUES (?, ?, ?)");
+        for (int i = 0; i < rowCount; ++i) {
+            const QDateTime start = now.addSecs(random.bounded(span) - span);
+            query.addBindValue(random.bounded(GOAL_COUNT) + 1);
+            query.addBindValue(start);
+            query.addBindValue(start.addSecs(300 + random.bounded(3300)));
+            if (!query.exec()) {
+                qCritical() << "Failed to insert timer record:" << query.lastError().text();
+                db.rollback();
+                return false;
+            }
+        }
+
+        return db.commit();
+    }
+
+    void sumPerGoal(QSqlDatabase& db, const QString& sql)
+    {
+        QSqlQuery query(db);
+        query.prepare(sql);
+        for (int goalId = 1; goalId <= GOAL_COUNT; ++goalId) {
+            query.addBindValue(goalId);
+            query.exec();
+            query.next();
+        }
+    }
+
+    void sumPerGoalInPeriod(QSqlDatabase& db, const QString& sql, const QVariant& start, const QVariant& end)
+    {
+        QSqlQuery query(db);
+        query.prepare(sql);
+        for (int goalId = 1; goalId <= GOAL_COUNT; ++goalId) {
+            query.addBindValue(goalId);
+            query.addBindValue(start);
+            query.addBindValue(end);
+            query.exec();
+            query.next();
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    const int rowCount = argc > 1 ? QString(argv[1]).toInt() : DEFAULT_ROW_COUNT;
+
+    QTemporaryDir dir;
+    QSqlDatabase db = QSqlDatabase::addDatabase(DatabaseConstants::DB_DRIVER);
+    db.setDatabaseName(dir.filePath(DatabaseConstants::DB_NAME));
+    if (!dir.isValid() || !db.open()) {
+        qCritical() << "Failed to open benchmark database:" << db.lastError().text();
+        return 1;
+    }
+
+    out << "Populating " << rowCount << " timer records...\n";
+    out.flush();
+    if (!populateLegacyDatabase(db, rowCount)) {
+        return 1;
+    }
+
+    const QDate periodStart = QDate::currentDate().addMonths(-1);
+    const QDate periodEnd = QDate::currentDate();
+    const QDateTime rangeStart = periodStart.startOfDay();
+    const QDateTime rangeEnd(periodEnd, QTime(23, 59, 59));
+
+    QList<Result> results = {
+        {"goal totals (all time)"},
+        {"goal totals (last month)"},
+        {"records in range (last month)"},
+    };
+
+    results[0].legacyMs = medianMs([&] { sumPerGoal(db, LEGACY_SUM_GOAL_TIME); });
+    results[1].legacyMs = medianMs([&] {
+        sumPerGoalInPeriod(db, LEGACY_SUM_GOAL_TIME_IN_PERIOD,
+                           periodStart.toString(DatabaseConstants::DATE_FORMAT),
+                           periodEnd.addDays(1).toString(DatabaseConstants::DATE_FORMAT));
+    });
+    results[2].legacyMs = medianMs([&] {
+        QSqlQuery query(db);
+        query.prepare(LEGACY_SELECT_TIMER_RECORDS_IN_RANGE);
+        query.addBindValue(rangeEnd);
+        query.addBindValue(rangeStart);
+        query.exec();
+        while (query.next()) {
+            query.value("start_time").toDateTime();
+            query.value("end_time").toDateTime();
+        }
+    });
+
+    QElapsedTimer migrationTimer;
+    migrationTimer.start();
+    if (!DatabaseSchemaManager::migrate(db)) {
+        return 1;
+    }
+    const qint64 migrationMs = migrationTimer.elapsed();
+
+    results[0].epochMs = medianMs([&] { sumPerGoal(db, DatabaseQueries::SUM_GOAL_TIME); });
+    results[1].epochMs = medianMs([&] {
+        const qint64 start = periodStart.startOfDay().toSecsSinceEpoch();
+        const qint64 end = periodEnd.addDays(1).startOfDay().toSecsSinceEpoch();
+        QSqlQuery query(db);
+        query.prepare(DatabaseQueries::SUM_GOAL_TIME_IN_PERIOD);
+        for (int goalId = 1; goalId <= GOAL_COUNT; ++goalId) {
+            // Same bind order as GoalRepository::getTimeSpentInPeriod
+            for (const QVariant& value : {QVariant(end), QVariant(start), QVariant(goalId),
+                                          QVariant(end), QVariant(start), QVariant(start)}) {
+                query.addBindValue(value);
+            }
+            query.exec();
+            query.next();
+        }
+    });
+    results[2].epochMs = medianMs([&] {
+        QSqlQuery query(db);
+        query.prepare(DatabaseQueries::SELECT_TIMER_RECORDS_IN_RANGE.arg("*"));
+        query.addBindValue(rangeEnd.toSecsSinceEpoch());
+        query.addBindValue(rangeStart.toSecsSinceEpoch());
+        query.addBindValue(rangeStart.toSecsSinceEpoch());
+        query.exec();
+        while (query.next()) {
+            QDateTime::fromSecsSinceEpoch(query.value("start_time").toLongLong());
+            QDateTime::fromSecsSinceEpoch(query.value("end_time").toLongLong());
+        }
+    });
+
+    out << "Migration to epoch layout: " << migrationMs << " ms\n\n";
+    out << QString("%1%2%3%4\n").arg("query", -32).arg("legacy ms", 14).arg("epoch ms", 14).arg("speedup", 14);
+    for (const Result& result : results) {
+        out << QString("%1%2%3%4\n")
+                   .arg(result.name, -32)
+                   .arg(result.legacyMs, 14, 'f', 2)
+                   .arg(result.epochMs, 14, 'f', 2)
+                   .arg(QString::number(result.legacyMs / qMax(result.epochMs, 0.001), 'f', 1) + "x", 14);
+    }
+    out.flush();
+
+    db.close();
+    return 0;
+}
@@ -0,0 +1,139 @@
+// Compares single-write latency under SQLite's default connection settings and
+// the tuned profile the application uses (WAL, synchronous=NORMAL, ...).
+// Every write is its own transaction, like addTimerRecord and toggleTodoCompletion.
+//
+// Usage: write_latency_benchmark [writes per profile, default 2000]
+
+#include "database/databaseconnectionprofile.h"
+#include "database/databaseconstants.h"
+#include "database/databaseschemamanager.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <algorithm>
+
+namespace {
+    const int DEFAULT_WRITE_COUNT = 2000;
+    const int TODO_COUNT = 100;
+
+    struct Result {
+        QString name;
+        double p50Ms = 0.0;
+        double p99Ms = 0.0;
+        double totalMs = 0.0;
+    };
+
+    double percentile(QList<double> samples, double fraction)
+    {
+        std::sort(samples.begin(), samples.end());
+        const int index = qBound(0, static_cast<int>(samples.size() * fraction), samples.size() - 1);
+        return samples.at(index);
+    }
+
+    bool prepareDatabase(QSqlDatabase& db, const DatabaseConnectionProfile& profile)
+    {
+        if (!profile.apply(db) ||
+            !DatabaseSchemaManager::createTables(db) ||
+            !DatabaseSchemaManager::createTriggers(db) ||
+            !DatabaseSchemaManager::migrate(db)) {
+            return false;
+        }
+
+        QSqlQuery query(db);
+        if (!query.exec("INSERT INTO goals (title) VALUES ('Benchmark')")) {
+            qCritical() << "Failed to insert goal:" << query.lastError().text();
+            return false;
+        }
+
+        db.transaction();
+        query.prepare("INSERT INTO todos (title, goal_id) VALUES (?, 1)");
+        for (int i = 0; i < TODO_COUNT; ++i) {
+            query.addBindValue(QString("Todo %1").arg(i));
+            query.exec();
+        }
+        return db.commit();
+    }
+
+    Result measure(const QString& name, const DatabaseConnectionProfile& profile, int writeCount)
+    {
+        Result result{name};
+
+        QTemporaryDir dir;
+        const QString connectionName = "benchmark_" + name;
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase(DatabaseConstants::DB_DRIVER, connectionName);
+            db.setDatabaseName(dir.filePath(DatabaseConstants::DB_NAME));
+            if (!dir.isValid() || !db.open() || !prepareDatabase(db, profile)) {
+                qCritical() << "Failed to prepare database for" << name << ":" << db.lastError().text();
+                return result;
+            }
+
+            QSqlQuery insert(db);
+            insert.prepare("INSERT INTO timer_records (goal_id, start_time, end_time, duration_seconds) "
+                           "VALUES (1, ?, ?, 1500)");
+            QSqlQuery toggle(db);
+            toggle.prepare("UPDATE todos SET is_completed = NOT is_completed WHERE id = ?");
+
+            const qint64 now = QDateTime::currentSecsSinceEpoch();
+            QList<double> samples;
+            QElapsedTimer total;
+            total.start();
+
+            // Alternate the two writes the UI issues most often
+            for (int i = 0; i < writeCount; ++i) {
+                QElapsedTimer timer;
+                timer.start();
+                if (i % 2 == 0) {
+                    insert.addBindValue(now + i * 1800);
+                    insert.addBindValue(now + i * 1800 + 1500);
+                    insert.exec();
+                } else {
+                    toggle.addBindValue(1 + i % TODO_COUNT);
+                    toggle.exec();
+                }
+                samples << timer.nsecsElapsed() / 1e6;
+            }
+
+            result.totalMs = total.nsecsElapsed() / 1e6;
+            result.p50Ms = percentile(samples, 0.50);
+            result.p99Ms = percentile(samples, 0.99);
+            db.close();
+        }
+        QSqlDatabase::removeDatabase(connectionName);
+
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    const int writeCount = argc > 1 ? QString(argv[1]).toInt() : DEFAULT_WRITE_COUNT;
+
+    out << "Running " << writeCount << " single-statement writes per profile...\n\n";
+    out.flush();
+
+    const QList<Result> results = {
+        measure("legacy", DatabaseConnectionProfile::legacy(), writeCount),
+        measure("tuned", DatabaseConnectionProfile::tuned(), writeCount),
+    };
+
+    out << QString("%1%2%3%4\n").arg("profile", -12).arg("p50 ms", 12).arg("p99 ms", 12).arg("total ms", 12);
+    for (const Result& result : results) {
+        out << QString("%1%2%3%4\n")
+                   .arg(result.name, -12)
+                   .arg(result.p50Ms, 12, 'f', 3)
+                   .arg(result.p99Ms, 12, 'f', 3)
+                   .arg(result.totalMs, 12, 'f', 1);
+    }
+    out.flush();
+
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <QWidget>
 #include <QDate>
 #include <QList>
+#include <QMap>
 #include "database/databasemanager.h"
 
 class QVBoxLayout;
@@ -30,6 +31,7 @@ private slots:
     void onTodayClicked();
     void onMonthSelected(int month);
     void onYearSelected(int year);
+    void onDataChanged(const DatabaseManager::ChangeSet& changes);
 
 private:
     // Constants
@@ -44,6 +46,8 @@ private:
     void connectSignals();
 
     // Data processing methods
+    void updateGoalTimePerDay(const QList<DatabaseManager::DailyGoalTotal>& totals);
+    QMap<QPair<QDate, int>, int>::const_iterator goalTimeBegin(const QDate& date) const;
     void updateDateDetails(const QDate& date);
     void updateCalendar();
     void updateCalendarWithGoalData();
@@ -68,8 +72,9 @@ private:
     QListWidget* m_activitiesList;
 
     // Data
-    QList<DatabaseManager::TimerRecord> m_timerRecords;
     QList<DatabaseManager::TodoItem> m_todos;
+    // Seconds per (day, goal id) within the month, from the daily rollup
+    QMap<QPair<QDate, int>, int> m_goalTimePerDay;
 };
 
 #endif // CALENDARWIDGET_H
\ No newline at end of file
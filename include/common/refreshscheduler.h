@@ -0,0 +1,60 @@
+#ifndef REFRESHSCHEDULER_H
+#define REFRESHSCHEDULER_H
+
+#include <QObject>
+#include <QDate>
+#include <QHash>
+#include <QTimer>
+#include <functional>
+
+class QWidget;
+
+// Decides when pages reload. A page whose inputs changed is refreshed right away
+// if it is on screen, otherwise it is only marked dirty and refreshed when it is
+// next shown. Every page goes dirty once at local midnight, when dates roll over.
+class RefreshScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    static RefreshScheduler& instance();
+
+    // Pages start dirty, so the first show loads them
+    void addPage(QWidget* page, std::function<void()> refresh);
+
+    // Refreshes on the next event-loop turn when visible; requests made
+    // meanwhile are merged into that one refresh
+    void invalidate(QWidget* page);
+    void invalidateAll();
+
+signals:
+    // Emitted once per day, right after local midnight
+    void dayChanged();
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    RefreshScheduler();
+
+    // Prevent copying
+    RefreshScheduler(const RefreshScheduler&) = delete;
+    RefreshScheduler& operator=(const RefreshScheduler&) = delete;
+
+    struct Page {
+        std::function<void()> refresh;
+        bool isDirty = true;
+        bool isScheduled = false;
+    };
+
+    void schedule(QWidget* page);
+    void runRefresh(QWidget* page);
+    void scheduleMidnight();
+    int msecsToMidnight() const;
+    void onMidnight();
+
+    QHash<QWidget*, Page> m_pages;
+    QTimer m_midnightTimer;
+    QDate m_today;
+};
+
+#endif // REFRESHSCHEDULER_H
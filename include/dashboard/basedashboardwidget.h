@@ -5,14 +5,18 @@
 #include <QFrame>
 #include <QHBoxLayout>
 #include <QLabel>
-#include <QListWidget>
+#include <QListView>
 #include <QScrollArea>
-#include <QTimer>
 #include <QVBoxLayout>
 #include <QWidget>
+#include <functional>
 
+#include "dashboard/dashboardsnapshot.h"
 #include "database/databasemanager.h"
 
+class CounterWidget;
+class TodoListModel;
+
 class BaseDashboardWidget : public QWidget {
     Q_OBJECT
 
@@ -37,7 +41,6 @@ signals:
 
 protected:
     // UI Constants
-    static constexpr int REFRESH_INTERVAL_MS = 60000;  // 1 minute
     static constexpr int DEFAULT_PADDING = 15;
     static constexpr int BORDER_RADIUS = 10;
 
@@ -57,32 +60,38 @@ protected:
     QLabel* m_titleLabel;
     QLabel* m_dateLabel;
 
-    // Statistics counter components
-    struct CounterSet {
-        QFrame* frame = nullptr;
-        QLabel* label = nullptr;
-        QLabel* value = nullptr;
+    // Statistics counter components. A counter is declared once by its definition;
+    // refreshes only hand in values, in the same order as the definitions
+    struct CounterDefinition {
+        QString title;
+        QString color;
+        std::function<QString(int)> format;  // Plain number when unset
+    };
+
+    struct CounterValue {
+        int number = 0;
+        QString text;  // Shown as is instead of the number when set
+        QString toolTip;
+
+        bool operator==(const CounterValue& other) const {
+            return number == other.number && text == other.text && toolTip == other.toolTip;
+        }
     };
 
     QWidget* m_statsWidget;
     QHBoxLayout* m_statsLayout;
-    CounterSet m_timeSpent;
-    CounterSet m_timersCompleted;
-    CounterSet m_pendingTodos;
-    CounterSet m_completedTodos;
+    QList<CounterWidget*> m_counters;
+    QList<CounterValue> m_counterValues;
 
     // Todo list components
     QHBoxLayout* m_pendingTodosHeaderLayout;
     QLabel* m_pendingTodosListLabel;
-    QScrollArea* m_pendingTodosScrollArea;
-    QListWidget* m_pendingTodosList;
+    QListView* m_pendingTodosList;
+    TodoListModel* m_pendingTodosModel;
 
     QLabel* m_completedTodosListLabel;
-    QScrollArea* m_completedTodosScrollArea;
-    QListWidget* m_completedTodosList;
-
-    // Timer for periodic refresh
-    QTimer* m_refreshTimer;
+    QListView* m_completedTodosList;
+    TodoListModel* m_completedTodosModel;
 
     // Statistics data
     int m_pendingTodosCount;
@@ -112,15 +121,16 @@ protected:
 
     void connectSignals();
 
-    void showEvent(QShowEvent *event) override;
-
     // Helper methods
-    QListWidgetItem* createTodoItem(const DatabaseManager::TodoItem& todo, bool isCompleted);
+    QListView* createTodoList(TodoListModel* model);
 
     QString formatTime(int seconds) const;
 
+    // Sets all four common counters from one window of the snapshot
+    void setFigures(const DashboardSnapshot::Figures& figures);
+
     // Event handlers
-    void onTodoItemDoubleClicked(QListWidgetItem* item);
+    void onTodoItemDoubleClicked(const QModelIndex& index);
 
     void onTodoItemRightClicked(const QPoint& pos);
 
@@ -128,23 +138,35 @@ protected:
 
     void onTodoToggled(int todoId, bool completed);
 
+    void onDataChanged(const DatabaseManager::ChangeSet& changes);
+
     // Abstract interface for subclasses
     virtual void doUpdateDateDisplay() = 0;
 
-    virtual void doCalculateStats() = 0;
+    // Picks this dashboard's figures out of the shared snapshot
+    virtual void doCalculateStats(const DashboardSnapshot::Data& snapshot) = 0;
 
-    virtual bool doShouldIncludeTodo(const DatabaseManager::TodoItem& todo) const = 0;
+    // Which todos the lists and counters cover; applied by the database, not here
+    virtual DatabaseManager::TodoFilter doGetTodoFilter() const = 0;
 
     virtual QString doGetWidgetTitle() const = 0;
 
+    // Counters a dashboard shows after the common four; none by default
+    virtual QList<CounterDefinition> doGetCounterDefinitions() const { return {}; }
+
+    // One value per extra counter, read on every refresh
+    virtual QList<CounterValue> doGetCounterValues() const { return {}; }
+
 private:
     // Non-virtual interface methods
     void updateDateDisplay();
-    void calculateStats();
-    bool shouldIncludeTodo(const DatabaseManager::TodoItem& todo) const;
+    DatabaseManager::TodoFilter getTodoFilter() const;
     QString getWidgetTitle() const;
+    void createCounters();
     void updateCounters();
     void updateTodosList();
+    void applySnapshot();
+    void onSnapshotUpdated();
 };
 
 #endif // BASEDASHBOARDWIDGET_H
\ No newline at end of file
@@ -3,7 +3,9 @@
 
 #include <QFrame>
 #include <QLabel>
+#include <QVariantAnimation>
 #include <QVBoxLayout>
+#include <functional>
 
 class CounterWidget : public QFrame {
     Q_OBJECT
@@ -12,7 +14,13 @@ public:
     explicit CounterWidget(const QString& title, const QString& value, const QString& color, QWidget* parent = nullptr);
     void updateValue(const QString& value);
 
+    // Numbers count from the one shown to the new one; a hidden counter jumps straight there
+    void setNumber(int number);
+    void setFormatter(std::function<QString(int)> formatter);
+
 private:
+    static constexpr int ANIMATION_DURATION_MS = 400;
+
     // Known color constants
     static const QString BLUE_COLOR;
     static const QString GREEN_COLOR;
@@ -26,11 +34,17 @@ private:
 
     void setupUi();
     QString getStyleForColor(const QString& color) const;
+    void showNumber(int number);
 
     QString m_title;
     QString m_color;
     QLabel* m_titleLabel;
     QLabel* m_valueLabel;
+
+    QVariantAnimation* m_animation;
+    std::function<QString(int)> m_formatter;
+    int m_number;
+    bool m_hasNumber;
 };
 
 #endif // COUNTERWIDGET_H
\ No newline at end of file
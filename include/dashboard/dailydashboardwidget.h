@@ -13,9 +13,9 @@ public:
 protected:
     void doUpdateDateDisplay() override;
 
-    void doCalculateStats() override;
+    void doCalculateStats(const DashboardSnapshot::Data& snapshot) override;
 
-    bool doShouldIncludeTodo(const DatabaseManager::TodoItem& todo) const override;
+    DatabaseManager::TodoFilter doGetTodoFilter() const override;
 
     QString doGetWidgetTitle() const override;
 
@@ -0,0 +1,82 @@
+#ifndef DASHBOARDSNAPSHOT_H
+#define DASHBOARDSNAPSHOT_H
+
+#include <QObject>
+#include <QDate>
+#include <QHash>
+#include <QMap>
+#include <memory>
+#include "database/databaseexecutor.h"
+#include "database/databasemanager.h"
+
+// Figures for every dashboard at once: today, this week, all time and each goal.
+// One executor job reads them after a change, and the result is published as an
+// immutable snapshot the dashboards share instead of querying on their own.
+class DashboardSnapshot : public QObject {
+    Q_OBJECT
+
+public:
+    // Focused time and todo counts over one window
+    struct Figures {
+        DatabaseManager::GoalTime time;
+        DatabaseManager::TodoCounts todos;
+    };
+
+    struct Data {
+        bool isLoaded = false;
+        QDate date;
+        QDate weekStart;  // Monday
+        QDate weekEnd;
+        Figures today;
+        Figures thisWeek;
+        Figures allTime;
+        QHash<int, Figures> goals;  // All time, by goal id
+    };
+
+    static DashboardSnapshot& instance();
+
+    // The last snapshot published; starts loading on first use
+    std::shared_ptr<const Data> current();
+
+signals:
+    // A new snapshot replaced the current one
+    void updated();
+
+private:
+    DashboardSnapshot();
+
+    // Prevent copying
+    DashboardSnapshot(const DashboardSnapshot&) = delete;
+    DashboardSnapshot& operator=(const DashboardSnapshot&) = delete;
+
+    // Each table is read by its own query, so a change only reruns the one it touched
+    enum Part {
+        Times = 0x1,
+        Todos = 0x2,
+        AllParts = Times | Todos
+    };
+
+    struct Reads {
+        QDate date;
+        int parts = 0;
+        QMap<int, DatabaseManager::GoalTimeWindows> times;
+        QMap<int, DatabaseManager::TodoCountWindows> todoCounts;
+    };
+
+    void load(int parts);
+    void onDataChanged(const DatabaseManager::ChangeSet& changes);
+    void publish();
+    static Reads read(DatabaseExecutor::Repositories& repositories, const QDate& date, int parts);
+
+    std::shared_ptr<const Data> m_current;
+    bool m_isLoading;
+    int m_queuedParts;
+
+    // Last rows read for m_date, kept so one part can be refreshed without the other
+    QDate m_date;
+    int m_loadedParts;
+    QMap<int, DatabaseManager::GoalTimeWindows> m_times;
+    QMap<int, DatabaseManager::TodoCountWindows> m_todoCounts;
+};
+
+#endif // DASHBOARDSNAPSHOT_H
@@ -29,17 +29,21 @@ public:
 
 protected:
     void setupUi() override;
-    void showEvent(QShowEvent* event) override;
 
     // BaseDashboardWidget interface implementation
     void doUpdateDateDisplay() override;
 
-    void doCalculateStats() override;
+    void doCalculateStats(const DashboardSnapshot::Data& snapshot) override;
 
-    bool doShouldIncludeTodo(const DatabaseManager::TodoItem& todo) const override;
+    DatabaseManager::TodoFilter doGetTodoFilter() const override;
 
     QString doGetWidgetTitle() const override;
 
+    // Time still to go on the goal's estimate
+    QList<CounterDefinition> doGetCounterDefinitions() const override;
+
+    QList<CounterValue> doGetCounterValues() const override;
+
 private slots:
     void onEditGoalClicked();
 
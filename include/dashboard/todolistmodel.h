@@ -0,0 +1,41 @@
+#ifndef TODOLISTMODEL_H
+#define TODOLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QIcon>
+#include <QList>
+
+#include "database/databasemanager.h"
+
+// Todos of one dashboard list. setTodos() turns the new list into row removals,
+// moves, insertions and dataChanged() for the rows that differ, so views keep
+// their scroll position and selection and only repaint what changed.
+class TodoListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    enum Roles {
+        TodoIdRole = Qt::UserRole,
+        CompletedRole
+    };
+
+    explicit TodoListModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    // Todos are matched by id; the list ends up in the order given
+    void setTodos(const QList<DatabaseManager::TodoItem>& todos);
+
+private:
+    static constexpr int MAX_DISPLAY_LENGTH = 80;
+
+    int rowOf(int todoId, int from) const;
+    static bool isShownAlike(const DatabaseManager::TodoItem& a, const DatabaseManager::TodoItem& b);
+
+    QList<DatabaseManager::TodoItem> m_todos;
+    QIcon m_pendingIcon;
+    QIcon m_completedIcon;
+};
+
+#endif // TODOLISTMODEL_H
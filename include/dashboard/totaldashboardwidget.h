@@ -13,11 +13,16 @@ public:
 protected:
     void doUpdateDateDisplay() override;
 
-    void doCalculateStats() override;
+    void doCalculateStats(const DashboardSnapshot::Data& snapshot) override;
 
-    bool doShouldIncludeTodo(const DatabaseManager::TodoItem& todo) const override;
+    DatabaseManager::TodoFilter doGetTodoFilter() const override;
 
     QString doGetWidgetTitle() const override;
+
+    // Streak, rolling average and this week's trend, from the running aggregates
+    QList<CounterDefinition> doGetCounterDefinitions() const override;
+
+    QList<CounterValue> doGetCounterValues() const override;
 };
 
 #endif // TOTALDASHBOARDWIDGET_H
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef DATABASECONNECTIONMANAGER_H
 #define DATABASECONNECTIONMANAGER_H
 
+#include "database/databaseconnectionprofile.h"
 #include <QSqlDatabase>
 #include <QString>
 
@@ -11,6 +12,13 @@ public:
     bool initialize();
     bool isInitialized() const { return m_isInitialized; }
     QSqlDatabase& database() { return m_database; }
+
+    // Takes effect on the next initialize(); defaults to DatabaseConnectionProfile::tuned()
+    void setProfile(const DatabaseConnectionProfile& profile) { m_profile = profile; }
+    const DatabaseConnectionProfile& profile() const { return m_profile; }
+
+    // Opens this file instead of the default location; takes effect on the next initialize()
+    void setDatabasePath(const QString& path) { m_databasePath = path; }
     
     bool beginTransaction();
     bool commitTransaction();
@@ -31,6 +39,8 @@ private:
     QString getDatabasePath() const;
     
     QSqlDatabase m_database;
+    DatabaseConnectionProfile m_profile;
+    QString m_databasePath;
     bool m_isInitialized;
 };
 
@@ -0,0 +1,28 @@
+#ifndef DATABASECONNECTIONPROFILE_H
+#define DATABASECONNECTIONPROFILE_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+// SQLite settings applied to a connection right after it opens.
+// Empty strings and zero sizes leave the corresponding setting untouched.
+struct DatabaseConnectionProfile {
+    QString journalMode;
+    QString synchronous;
+    int cacheSizeKiB = 0;
+    qint64 mmapSizeBytes = 0;
+    QString tempStore;
+    bool foreignKeys = false;
+    int busyTimeoutMs = 0;
+
+    // SQLite's own defaults: rollback journal, synchronous=FULL, no foreign keys
+    static DatabaseConnectionProfile legacy();
+
+    // WAL so readers on other connections never wait for the writer, and
+    // synchronous=NORMAL so commits no longer fsync (still durable at checkpoints)
+    static DatabaseConnectionProfile tuned();
+
+    bool apply(QSqlDatabase& db) const;
+};
+
+#endif // DATABASECONNECTIONPROFILE_H
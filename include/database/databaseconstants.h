@@ -15,6 +15,7 @@ namespace DatabaseConstants {
     const QString TABLE_GOALS = "goals";
     const QString TABLE_TODOS = "todos";
     const QString TABLE_TIMER_RECORDS = "timer_records";
+    const QString TABLE_DAILY_GOAL_TOTALS = "daily_goal_totals";
     
     // Default values
     const int DEFAULT_PRIORITY = 1;
@@ -59,6 +60,7 @@ namespace DatabaseQueries {
         "last_update DATETIME DEFAULT CURRENT_TIMESTAMP, "
         "FOREIGN KEY(goal_id) REFERENCES goals(id) ON DELETE CASCADE)";
     
+    // Original DATETIME text layout; migration 3 rebuilds it with epoch seconds
     const QString CREATE_TIMER_RECORDS_TABLE = 
         "CREATE TABLE IF NOT EXISTS timer_records ("
         "id INTEGER PRIMARY KEY AUTOINCREMENT,"
@@ -76,18 +78,256 @@ namespace DatabaseQueries {
         "    UPDATE todos SET last_update = CURRENT_TIMESTAMP WHERE id = NEW.id; "
         "END";
     
+    // Schema migrations (see DatabaseSchemaManager::migrate)
+    const QString CREATE_TIMER_RECORDS_START_INDEX =
+        "CREATE INDEX IF NOT EXISTS idx_timer_records_start_time "
+        "ON timer_records(start_time)";
+
+    const QString CREATE_TIMER_RECORDS_GOAL_START_INDEX =
+        "CREATE INDEX IF NOT EXISTS idx_timer_records_goal_start "
+        "ON timer_records(goal_id, start_time)";
+
+    const QString CREATE_TODOS_DATE_RANGE_INDEX =
+        "CREATE INDEX IF NOT EXISTS idx_todos_date_range "
+        "ON todos(start_date, end_date, is_completed)";
+
+    const QString CREATE_TODOS_GOAL_INDEX =
+        "CREATE INDEX IF NOT EXISTS idx_todos_goal "
+        "ON todos(goal_id, is_completed)";
+
+    // Timer records as UTC epoch seconds with a stored duration. Legacy values are
+    // local time without an offset, which is what strftime's 'utc' modifier expects
+    const QString CREATE_TIMER_RECORDS_EPOCH_TABLE =
+        "CREATE TABLE timer_records_epoch ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "goal_id INTEGER,"
+        "start_time INTEGER NOT NULL,"
+        "end_time INTEGER NOT NULL,"
+        "duration_seconds INTEGER NOT NULL,"
+        "CHECK (duration_seconds = end_time - start_time),"
+        "FOREIGN KEY(goal_id) REFERENCES goals(id) ON DELETE SET NULL"
+        ")";
+
+    // Rows whose times strftime cannot parse are not copied; they are kept as they
+    // were in timer_records_unparsed instead of disappearing with the old table
+    const QString UNPARSED_TIMER_RECORDS_CONDITION =
+        "strftime('%s', start_time, 'utc') IS NULL OR strftime('%s', end_time, 'utc') IS NULL";
+
+    const QString COUNT_UNPARSED_TIMER_RECORDS =
+        "SELECT COUNT(*) FROM timer_records WHERE " + UNPARSED_TIMER_RECORDS_CONDITION;
+
+    const QString SAVE_UNPARSED_TIMER_RECORDS =
+        "CREATE TABLE timer_records_unparsed AS SELECT * FROM timer_records WHERE " +
+        UNPARSED_TIMER_RECORDS_CONDITION;
+
+    const QString COPY_TIMER_RECORDS_TO_EPOCH_TABLE =
+        "INSERT INTO timer_records_epoch (id, goal_id, start_time, end_time, duration_seconds) "
+        "SELECT id, goal_id, start_epoch, end_epoch, end_epoch - start_epoch FROM ("
+        "    SELECT id, goal_id, "
+        "    CAST(strftime('%s', start_time, 'utc') AS INTEGER) AS start_epoch, "
+        "    CAST(strftime('%s', end_time, 'utc') AS INTEGER) AS end_epoch "
+        "    FROM timer_records"
+        ") WHERE start_epoch IS NOT NULL AND end_epoch IS NOT NULL";
+
+    const QString DROP_TIMER_RECORDS_TABLE = "DROP TABLE timer_records";
+
+    const QString RENAME_TIMER_RECORDS_EPOCH_TABLE =
+        "ALTER TABLE timer_records_epoch RENAME TO timer_records";
+
+    // Covering indexes: period and per-goal sums never touch the table rows
+    const QString CREATE_TIMER_RECORDS_START_COVERING_INDEX =
+        "CREATE INDEX IF NOT EXISTS idx_timer_records_start "
+        "ON timer_records(start_time, goal_id, duration_seconds)";
+
+    const QString CREATE_TIMER_RECORDS_GOAL_COVERING_INDEX =
+        "CREATE INDEX IF NOT EXISTS idx_timer_records_goal "
+        "ON timer_records(goal_id, start_time, duration_seconds)";
+
+    const QString CREATE_TIMER_RECORDS_DURATION_INDEX =
+        "CREATE INDEX IF NOT EXISTS idx_timer_records_duration "
+        "ON timer_records(duration_seconds)";
+
+    // "No goal" used to be stored as -1 or 0, which foreign key enforcement rejects
+    const QString CLEAR_DANGLING_TODO_GOALS =
+        "UPDATE todos SET goal_id = NULL "
+        "WHERE goal_id IS NOT NULL AND goal_id NOT IN (SELECT id FROM goals)";
+
+    const QString CLEAR_DANGLING_TIMER_RECORD_GOALS =
+        "UPDATE timer_records SET goal_id = NULL "
+        "WHERE goal_id IS NOT NULL AND goal_id NOT IN (SELECT id FROM goals)";
+
+    // Focused time per local day and goal, kept in step with timer_records by the
+    // triggers below. goal_id is NO_GOAL_ID instead of NULL so it can be part of the key
+    const QString CREATE_DAILY_GOAL_TOTALS_TABLE =
+        "CREATE TABLE IF NOT EXISTS daily_goal_totals ("
+        "day TEXT NOT NULL,"
+        "goal_id INTEGER NOT NULL,"
+        "seconds INTEGER NOT NULL,"
+        "sessions INTEGER NOT NULL,"
+        "PRIMARY KEY (day, goal_id)"
+        ") WITHOUT ROWID";
+
+    // Seconds of a session that fall on its end day, 0 when it ends on the day it started
+    const QString DAILY_GOAL_TOTALS_END_DAY_SECONDS =
+        "CASE WHEN date(end_time, 'unixepoch', 'localtime') > date(start_time, 'unixepoch', 'localtime') "
+        "THEN end_time - CAST(strftime('%s', date(end_time, 'unixepoch', 'localtime'), 'utc') AS INTEGER) "
+        "ELSE 0 END";
+
+    // Per-day pieces of the timer records in %1, a table or a one-row subquery, with
+    // every total multiplied by %2. Sessions are split at the midnight before they
+    // end; ones longer than a day keep their middle days on the start day
+    const QString DAILY_GOAL_TOTALS_PIECES =
+        QString("SELECT day, goal_id, %2 * seconds AS seconds, %2 * sessions AS sessions FROM ("
+                "SELECT date(start_time, 'unixepoch', 'localtime') AS day, IFNULL(goal_id, -1) AS goal_id, "
+                "duration_seconds - %3 AS seconds, 1 AS sessions FROM %1 "
+                "UNION ALL "
+                "SELECT date(end_time, 'unixepoch', 'localtime'), IFNULL(goal_id, -1), %3, 0 FROM %1 "
+                "WHERE %3 > 0)").replace("%3", DAILY_GOAL_TOTALS_END_DAY_SECONDS);
+
+    // "WHERE true" keeps SQLite from reading ON CONFLICT as a join constraint
+    const QString UPSERT_DAILY_GOAL_TOTALS =
+        "INSERT INTO daily_goal_totals (day, goal_id, seconds, sessions) %1 WHERE true "
+        "ON CONFLICT(day, goal_id) DO UPDATE SET "
+        "seconds = seconds + excluded.seconds, sessions = sessions + excluded.sessions";
+
+    // The trigger row (%1 is NEW or OLD) as a one-row subquery
+    const QString DAILY_GOAL_TOTALS_TRIGGER_ROW =
+        "(SELECT %1.goal_id AS goal_id, %1.start_time AS start_time, "
+        "%1.end_time AS end_time, %1.duration_seconds AS duration_seconds)";
+
+    // Drops the days of OLD that no session touches anymore
+    const QString PRUNE_DAILY_GOAL_TOTALS =
+        "DELETE FROM daily_goal_totals WHERE goal_id = IFNULL(OLD.goal_id, -1) "
+        "AND day IN (date(OLD.start_time, 'unixepoch', 'localtime'), date(OLD.end_time, 'unixepoch', 'localtime')) "
+        "AND seconds = 0 AND sessions = 0";
+
+    const QString FILL_DAILY_GOAL_TOTALS =
+        "INSERT INTO daily_goal_totals (day, goal_id, seconds, sessions) "
+        "SELECT day, goal_id, SUM(seconds), SUM(sessions) FROM (" +
+        DAILY_GOAL_TOTALS_PIECES.arg("timer_records", "1") + ") GROUP BY day, goal_id";
+
+    const QString CREATE_DAILY_GOAL_TOTALS_INSERT_TRIGGER =
+        "CREATE TRIGGER IF NOT EXISTS daily_goal_totals_insert "
+        "AFTER INSERT ON timer_records "
+        "FOR EACH ROW "
+        "BEGIN " +
+        UPSERT_DAILY_GOAL_TOTALS.arg(DAILY_GOAL_TOTALS_PIECES.arg(DAILY_GOAL_TOTALS_TRIGGER_ROW.arg("NEW"), "1")) + "; "
+        "END";
+
+    const QString CREATE_DAILY_GOAL_TOTALS_DELETE_TRIGGER =
+        "CREATE TRIGGER IF NOT EXISTS daily_goal_totals_delete "
+        "AFTER DELETE ON timer_records "
+        "FOR EACH ROW "
+        "BEGIN " +
+        UPSERT_DAILY_GOAL_TOTALS.arg(DAILY_GOAL_TOTALS_PIECES.arg(DAILY_GOAL_TOTALS_TRIGGER_ROW.arg("OLD"), "-1")) + "; " +
+        PRUNE_DAILY_GOAL_TOTALS + "; "
+        "END";
+
+    // Also fires for ON DELETE SET NULL when a goal is removed
+    const QString CREATE_DAILY_GOAL_TOTALS_UPDATE_TRIGGER =
+        "CREATE TRIGGER IF NOT EXISTS daily_goal_totals_update "
+        "AFTER UPDATE OF goal_id, start_time, end_time, duration_seconds ON timer_records "
+        "FOR EACH ROW "
+        "BEGIN " +
+        UPSERT_DAILY_GOAL_TOTALS.arg(DAILY_GOAL_TOTALS_PIECES.arg(DAILY_GOAL_TOTALS_TRIGGER_ROW.arg("OLD"), "-1")) + "; " +
+        UPSERT_DAILY_GOAL_TOTALS.arg(DAILY_GOAL_TOTALS_PIECES.arg(DAILY_GOAL_TOTALS_TRIGGER_ROW.arg("NEW"), "1")) + "; " +
+        PRUNE_DAILY_GOAL_TOTALS + "; "
+        "END";
+
+    // Hot queries - shared by the repositories and the startup query plan check.
+    // %1 in a SELECT stands for the column list, see RowMapping::select
+    // Overlap test; the longest stored session gives start_time a lower bound
+    const QString SELECT_TIMER_RECORDS_IN_RANGE =
+        "SELECT %1 FROM timer_records WHERE start_time <= ? AND end_time >= ? "
+        "AND start_time >= ? - (SELECT IFNULL(MAX(duration_seconds), 0) FROM timer_records) "
+        "ORDER BY start_time DESC";
+
+    const QString SUM_GOAL_TIME =
+        "SELECT SUM(duration_seconds) FROM timer_records WHERE goal_id = ?";
+
+    // Overlapping sessions clipped to the period, so ones crossing its edges count
+    // only the part inside; bounded like SELECT_TIMER_RECORDS_IN_RANGE
+    const QString SUM_GOAL_TIME_IN_PERIOD =
+        "SELECT SUM(MIN(start_time + duration_seconds, ?) - MAX(start_time, ?)) FROM timer_records "
+        "WHERE goal_id = ? AND start_time < ? AND start_time + duration_seconds > ? "
+        "AND start_time >= ? - (SELECT IFNULL(MAX(duration_seconds), 0) FROM timer_records)";
+
+    // goal_id is grouped raw so the goal index supplies the order; NULL and
+    // NO_GOAL_ID rows are merged by the caller
+    const QString SUM_TIME_PER_GOAL =
+        "SELECT goal_id, SUM(duration_seconds), COUNT(*) FROM timer_records "
+        "GROUP BY goal_id";
+
+    // Clipped like SUM_GOAL_TIME_IN_PERIOD; sessions count where they started
+    const QString SUM_TIME_PER_GOAL_IN_PERIOD =
+        "SELECT goal_id, SUM(MIN(start_time + duration_seconds, ?) - MAX(start_time, ?)), "
+        "SUM(start_time >= ?) FROM timer_records "
+        "WHERE start_time < ? AND start_time + duration_seconds > ? "
+        "AND start_time >= ? - (SELECT IFNULL(MAX(duration_seconds), 0) FROM timer_records) "
+        "GROUP BY goal_id";
+
+    const QString SELECT_TODOS_IN_RANGE =
+        "SELECT %1 FROM todos WHERE ((start_date <= ? AND end_date >= ?) OR "
+        "(end_date IS NULL AND start_date BETWEEN ? AND ?) OR "
+        "(start_date IS NULL AND end_date BETWEEN ? AND ?))";
+
+    const QString PENDING_TODOS_CONDITION = " AND is_completed = 0";
+
+    // Building blocks of TodoRepository::findMatching(). A missing
+    // start or end date leaves that side of the todo open, so undated todos always overlap
+    const QString SELECT_TODOS_MATCHING = "SELECT %1 FROM todos WHERE 1 = 1";
+    const QString TODOS_OVERLAP_CONDITION =
+        " AND (start_date IS NULL OR start_date <= ?) AND (end_date IS NULL OR end_date >= ?)";
+    const QString TODOS_GOAL_CONDITION = " AND goal_id = ?";
+    const QString TODOS_ORDER = " ORDER BY priority DESC, id ASC";
+
     // Common queries
     const QString SELECT_ALL_GOALS = 
-        "SELECT * FROM goals ORDER BY priority DESC, id ASC";
+        "SELECT %1 FROM goals ORDER BY priority DESC, id ASC";
+    
+    const QString SELECT_PENDING_GOALS = 
+        "SELECT %1 FROM goals WHERE is_completed = 0 ORDER BY priority DESC, id ASC";
     
     const QString SELECT_ALL_TODOS = 
-        "SELECT * FROM todos ORDER BY priority DESC, id ASC";
+        "SELECT %1 FROM todos ORDER BY priority DESC, id ASC";
+    
+    const QString SELECT_PENDING_TODOS = 
+        "SELECT %1 FROM todos WHERE is_completed = 0 ORDER BY priority DESC, id ASC";
     
     const QString SELECT_GOAL_BY_ID = 
-        "SELECT id, title, description, priority, is_completed, estimated_time, color_code FROM goals WHERE id = ?";
+        "SELECT %1 FROM goals WHERE id = ?";
     
     const QString SELECT_TODO_BY_ID = 
-        "SELECT id, title, description, priority, is_completed, goal_id, color_code, start_date, end_date, last_update FROM todos WHERE id = ?";
+        "SELECT %1 FROM todos WHERE id = ?";
+    
+    const QString SELECT_TIMER_RECORD_BY_ID = 
+        "SELECT %1 FROM timer_records WHERE id = ?";
+
+    // Ids only grow (AUTOINCREMENT), so this is everything stored since id was read
+    const QString SELECT_TIMER_RECORDS_AFTER_ID =
+        "SELECT %1 FROM timer_records WHERE id > ? ORDER BY id";
+
+    const QString SELECT_DAILY_GOAL_TOTALS_IN_RANGE =
+        "SELECT day, goal_id, seconds, sessions FROM daily_goal_totals "
+        "WHERE day BETWEEN ? AND ? ORDER BY day, goal_id";
+
+    // Dashboard figures, one pass each: every goal's time today, this week and all
+    // time from the rollup (a row per day and goal, so reading it all stays cheap)...
+    const QString SUM_DAILY_GOAL_TOTALS_BY_WINDOW =
+        "SELECT goal_id, "
+        "SUM(CASE WHEN day = ? THEN seconds ELSE 0 END), SUM(CASE WHEN day = ? THEN sessions ELSE 0 END), "
+        "SUM(CASE WHEN day BETWEEN ? AND ? THEN seconds ELSE 0 END), "
+        "SUM(CASE WHEN day BETWEEN ? AND ? THEN sessions ELSE 0 END), "
+        "SUM(seconds), SUM(sessions) FROM daily_goal_totals GROUP BY goal_id";
+
+    // ...and every goal's todos overlapping today, overlapping this week and in total,
+    // split by completion. Overlap reads like TODOS_OVERLAP_CONDITION. Both read whole
+    // tables on purpose; DashboardSnapshot only reruns the one whose table a change touched
+    const QString COUNT_TODOS_BY_WINDOW =
+        "SELECT goal_id, is_completed, "
+        "SUM((start_date IS NULL OR start_date <= ?) AND (end_date IS NULL OR end_date >= ?)), "
+        "SUM((start_date IS NULL OR start_date <= ?) AND (end_date IS NULL OR end_date >= ?)), "
+        "COUNT(*) FROM todos GROUP BY goal_id, is_completed";
 }
 
 namespace ColorConstants {
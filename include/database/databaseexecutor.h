@@ -0,0 +1,116 @@
+#ifndef DATABASEEXECUTOR_H
+#define DATABASEEXECUTOR_H
+
+#include "database/databasemanager.h"
+#include "database/repositories/goalrepository.h"
+#include "database/repositories/todorepository.h"
+#include "database/repositories/timerrepository.h"
+#include <QFuture>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QSqlDatabase>
+#include <QThread>
+#include <functional>
+#include <memory>
+
+// Runs read-only repository calls on a worker thread that owns its own connection,
+// so slow queries never block the GUI thread. Writes stay on DatabaseManager.
+class DatabaseExecutor : public QObject {
+    Q_OBJECT
+
+public:
+    struct Repositories {
+        explicit Repositories(QSqlDatabase& db) : goals(db), todos(db), timers(db) {}
+
+        GoalRepository goals;
+        TodoRepository todos;
+        TimerRepository timers;
+    };
+
+    static DatabaseExecutor& instance();
+
+    bool initialize();
+    bool isRunning() const { return m_isRunning; }
+    void shutdown();
+
+    // Read operations
+    QFuture<QList<DatabaseManager::TimerRecord>> getTimerRecords(const QDateTime& start, const QDateTime& end);
+    QFuture<QList<DatabaseManager::TimerRecord>> getTimerRecordsAfter(int id);
+    QFuture<QList<DatabaseManager::DailyGoalTotal>> getDailyGoalTotals(const QDate& startDate, const QDate& endDate);
+    QFuture<QList<DatabaseManager::TodoItem>> getAllTodos(bool includeCompleted = true);
+    QFuture<QList<DatabaseManager::TodoItem>> getTodos(const DatabaseManager::TodoFilter& filter);
+    QFuture<QMap<int, DatabaseManager::GoalTime>> getTimePerGoal();
+    QFuture<QMap<int, DatabaseManager::GoalTime>> getTimePerGoalInPeriod(const QDate& startDate, const QDate& endDate);
+
+    // Runs job on the worker thread; jobs execute in the order they were queued
+    template <typename T>
+    QFuture<T> run(std::function<T(Repositories&)> job);
+
+    // Calls callback(result) on context's thread once future finishes,
+    // unless context has been destroyed by then
+    template <typename T, typename Callback>
+    static void deliver(const QFuture<T>& future, QObject* context, Callback callback);
+
+private:
+    DatabaseExecutor();
+    ~DatabaseExecutor();
+
+    // Prevent copying
+    DatabaseExecutor(const DatabaseExecutor&) = delete;
+    DatabaseExecutor& operator=(const DatabaseExecutor&) = delete;
+
+    bool openConnection(const QString& databasePath);
+    void closeConnection();
+    void post(std::function<void()> task);
+    Repositories& fallbackRepositories();
+
+    static const QString CONNECTION_NAME;
+
+    QThread* m_thread;
+    QObject* m_worker;  // Lives on m_thread; tasks are queued to it
+
+    // Only touched on m_thread
+    QSqlDatabase m_database;
+    std::unique_ptr<Repositories> m_repositories;
+
+    // Used on the calling thread when the worker could not be started
+    std::unique_ptr<Repositories> m_fallbackRepositories;
+
+    bool m_isRunning;
+};
+
+template <typename T>
+QFuture<T> DatabaseExecutor::run(std::function<T(Repositories&)> job)
+{
+    QFutureInterface<T> promise;
+    promise.reportStarted();
+    QFuture<T> future = promise.future();
+
+    if (!m_isRunning) {
+        promise.reportResult(job(fallbackRepositories()));
+        promise.reportFinished();
+        return future;
+    }
+
+    post([this, promise, job]() mutable {
+        promise.reportResult(job(*m_repositories));
+        promise.reportFinished();
+    });
+
+    return future;
+}
+
+template <typename T, typename Callback>
+void DatabaseExecutor::deliver(const QFuture<T>& future, QObject* context, Callback callback)
+{
+    // The watcher lives on context's thread, so finished() arrives there queued
+    auto* watcher = new QFutureWatcher<T>(context);
+    QObject::connect(watcher, &QFutureWatcher<T>::finished, context, [watcher, callback]() {
+        callback(watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(future);
+}
+
+#endif // DATABASEEXECUTOR_H
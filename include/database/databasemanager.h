@@ -2,11 +2,14 @@
 #define DATABASEMANAGER_H
 
 #include <QObject>
+#include <QColor>
 #include <QDateTime>
 #include <QString>
 #include <QList>
 #include <QDate>
+#include <QMap>
 #include <memory>
+#include <optional>
 
 class GoalRepository;
 class TodoRepository;
@@ -53,6 +56,79 @@ public:
         int goalId = -1;
     };
 
+    // Focused time and session count for one goal
+    struct GoalTime {
+        int seconds = 0;
+        int sessions = 0;
+    };
+
+    // Key used for sessions recorded without a goal
+    static constexpr int NO_GOAL_ID = -1;
+
+    // Which todos a view shows, answered by TodoRepository in SQL. Invalid dates
+    // leave the window open on that side; goalId only narrows when it is set
+    struct TodoFilter {
+        QDate startDate;
+        QDate endDate;
+        std::optional<int> goalId;
+        bool includeCompleted = true;
+    };
+
+    struct TodoCounts {
+        int pending = 0;
+        int completed = 0;
+    };
+
+    // One goal's figures today, in the current week and all time, each read in one pass
+    struct GoalTimeWindows {
+        GoalTime today;
+        GoalTime week;
+        GoalTime total;
+    };
+
+    struct TodoCountWindows {
+        TodoCounts today;
+        TodoCounts week;
+        TodoCounts total;
+    };
+
+    // Focused time of one goal on one local day, from the daily_goal_totals rollup
+    struct DailyGoalTotal {
+        QDate day;
+        int goalId = NO_GOAL_ID;
+        int seconds = 0;
+        int sessions = 0;
+    };
+
+    // Change notifications
+    enum class Entity {
+        Goal,
+        Todo,
+        TimerRecord
+    };
+
+    enum class Operation {
+        Added,
+        Updated,
+        Removed,
+        Cleared
+    };
+
+    struct ChangeEvent {
+        Entity entity = Entity::Goal;
+        Operation operation = Operation::Updated;
+        int id = -1;  // -1 when the affected rows are not known one by one; Cleared marks a cleared table
+    };
+
+    // Writes made during one event-loop turn, merged per entity and id
+    struct ChangeSet {
+        QList<ChangeEvent> events;
+
+        bool affects(Entity entity) const;
+        bool affectsOnly(Entity entity) const;
+        bool isEmpty() const { return events.isEmpty(); }
+    };
+
     // Singleton access
     static DatabaseManager& instance();
 
@@ -74,10 +150,13 @@ public:
     QList<GoalItem> getAllGoals(bool includeCompleted = true);
     bool toggleGoalCompletion(int id, bool completed);
     bool completeGoal(int goalId);
+    QColor getGoalColor(int id) const;
 
     // Goal time tracking
     int getGoalTimeSpent(int goalId);
     int getGoalTimeSpentInPeriod(int goalId, const QDate& startDate, const QDate& endDate);
+    QMap<int, GoalTime> getTimePerGoal();
+    QMap<int, GoalTime> getTimePerGoalInPeriod(const QDate& startDate, const QDate& endDate);
 
     // Todos operations
     bool addTodo(const TodoItem& todo);
@@ -94,7 +173,7 @@ public:
     QStringList getAvailableColors();
 
 signals:
-    void dataChanged();
+    void dataChanged(const DatabaseManager::ChangeSet& changes);
 
 private:
     DatabaseManager();
@@ -106,14 +185,31 @@ private:
 
     bool setupDatabase();
     void initializeRepositories();
-    void emitDataChanged();
+    void recordChange(Entity entity, Operation operation, int id = -1);
+    void flushChanges();
+
+    // Goal cache - loaded once, then kept in step with every goal write
+    struct CachedGoal {
+        GoalItem goal;
+        QColor color;
+    };
+
+    void loadGoalCache();
+    void cacheGoal(const GoalItem& goal);
 
     // Repository instances
     std::unique_ptr<GoalRepository> m_goalRepository;
     std::unique_ptr<TodoRepository> m_todoRepository;
     std::unique_ptr<TimerRepository> m_timerRepository;
 
+    QMap<int, CachedGoal> m_goalCache;
+
+    ChangeSet m_pendingChanges;
+    bool m_changeFlushScheduled;
+
     bool m_isInitialized;
 };
 
+Q_DECLARE_METATYPE(DatabaseManager::ChangeSet)
+
 #endif // DATABASEMANAGER_H
\ No newline at end of file
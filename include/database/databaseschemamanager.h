@@ -2,22 +2,52 @@
 #define DATABASESCHEMAMANAGER_H
 
 #include <QSqlDatabase>
+#include <QStringList>
 
 class DatabaseSchemaManager {
 public:
     static bool createTables(QSqlDatabase& db);
     static bool createTriggers(QSqlDatabase& db);
+    static bool migrate(QSqlDatabase& db);
     static bool verifySchema(QSqlDatabase& db);
-    
+    static bool verifyQueryPlans(QSqlDatabase& db);
+
+    static int schemaVersion(QSqlDatabase& db);
+    static int latestSchemaVersion();
+
 private:
+    // A schema upgrade step; the database is at `version` once its statements have run
+    struct Migration {
+        int version;
+        QString description;
+        QStringList statements;
+        QString setAsideQuery;  // Counts rows the statements cannot convert; logged when any
+    };
+
+    // A query whose plan must never fall back to a full scan of `table`, or, for one
+    // that reads it whole on purpose, never sort its rows to group them
+    struct HotQuery {
+        QString name;
+        QString table;
+        QString sql;
+        bool readsWholeTable = false;
+    };
+
+    static const QList<Migration>& migrations();
+    static const QList<HotQuery>& hotQueries();
+
     static bool createGoalsTable(QSqlDatabase& db);
     static bool createTodosTable(QSqlDatabase& db);
     static bool createTimerRecordsTable(QSqlDatabase& db);
     static bool createTodosUpdateTrigger(QSqlDatabase& db);
-    
+
+    static bool applyMigration(QSqlDatabase& db, const Migration& migration);
+    static bool foreignKeysEnabled(QSqlDatabase& db);
+    static bool setSchemaVersion(QSqlDatabase& db, int version);
+    static QStringList explainQueryPlan(QSqlDatabase& db, const QString& query);
     static bool executeQuery(QSqlDatabase& db, const QString& query, const QString& operation);
-    
+
     DatabaseSchemaManager() = delete; // Static utility class
 };
 
-#endif // DATABASESCHEMAMANAGER_H
\ No newline at end of file
+#endif // DATABASESCHEMAMANAGER_H
@@ -0,0 +1,51 @@
+#ifndef PREPAREDSTATEMENTCACHE_H
+#define PREPAREDSTATEMENTCACHE_H
+
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <memory>
+
+// A cached statement checked out for a single call. Going out of scope resets it,
+// so a SELECT that was not read to the end never pins a read transaction.
+class PreparedStatement {
+public:
+    explicit PreparedStatement(const QSqlQuery& query) : m_query(query) {}
+    ~PreparedStatement() { m_query.finish(); }
+
+    PreparedStatement(const PreparedStatement&) = delete;
+    PreparedStatement& operator=(const PreparedStatement&) = delete;
+
+    QSqlQuery& operator*() { return m_query; }
+    QSqlQuery* operator->() { return &m_query; }
+
+private:
+    QSqlQuery m_query;  // Shares its result with the copy held by the cache
+};
+
+// Prepared statements for one connection, keyed by SQL text. Statements are
+// parsed and planned once, then rebound on every call.
+//
+// Like the connection itself, a cache must only be used from the thread that
+// opened the connection. A statement must not be checked out twice at once.
+class PreparedStatementCache {
+public:
+    // Shared by every repository working on db's connection
+    static std::shared_ptr<PreparedStatementCache> forDatabase(const QSqlDatabase& db);
+
+    // Finalizes db's statements; call before closing the connection
+    static void release(const QSqlDatabase& db);
+
+    explicit PreparedStatementCache(const QSqlDatabase& db);
+
+    // Binding positions start over at the first addBindValue after each exec()
+    PreparedStatement prepare(const QString& sql);
+    void clear();
+
+private:
+    QSqlDatabase m_database;
+    QHash<QString, QSqlQuery> m_statements;
+};
+
+#endif // PREPAREDSTATEMENTCACHE_H
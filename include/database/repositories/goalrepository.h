@@ -2,15 +2,18 @@
 #define GOALREPOSITORY_H
 
 #include "database/databasemanager.h"
+#include "database/preparedstatementcache.h"
 #include <QList>
+#include <QMap>
 #include <QSqlDatabase>
+#include <memory>
 #include <optional>
 
 class GoalRepository {
 public:
     explicit GoalRepository(QSqlDatabase& db);
     
-    bool add(const DatabaseManager::GoalItem& goal);
+    std::optional<int> add(const DatabaseManager::GoalItem& goal);
     bool update(const DatabaseManager::GoalItem& goal);
     bool remove(int id);
     
@@ -22,12 +25,14 @@ public:
     
     int getTimeSpent(int goalId) const;
     int getTimeSpentInPeriod(int goalId, const QDate& startDate, const QDate& endDate) const;
+    QMap<int, DatabaseManager::GoalTime> getTimePerGoal() const;
+    QMap<int, DatabaseManager::GoalTime> getTimePerGoalInPeriod(const QDate& startDate, const QDate& endDate) const;
     
 private:
-    DatabaseManager::GoalItem mapFromQuery(const QSqlQuery& query) const;
-    bool bindGoalToQuery(QSqlQuery& query, const DatabaseManager::GoalItem& goal) const;
+    QMap<int, DatabaseManager::GoalTime> collectTimePerGoal(QSqlQuery& query) const;
     
     QSqlDatabase& m_database;
+    std::shared_ptr<PreparedStatementCache> m_statements;
 };
 
 #endif // GOALREPOSITORY_H
\ No newline at end of file
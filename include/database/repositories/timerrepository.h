@@ -2,25 +2,31 @@
 #define TIMERREPOSITORY_H
 
 #include "database/databasemanager.h"
+#include "database/preparedstatementcache.h"
 #include <QList>
+#include <QMap>
 #include <QSqlDatabase>
 #include <QDateTime>
+#include <memory>
 #include <optional>
 
 class TimerRepository {
 public:
     explicit TimerRepository(QSqlDatabase& db);
     
-    bool add(const DatabaseManager::TimerRecord& record);
+    std::optional<int> add(const DatabaseManager::TimerRecord& record);
     std::optional<DatabaseManager::TimerRecord> findById(int id) const;
     QList<DatabaseManager::TimerRecord> findByDateRange(const QDateTime& start, const QDateTime& end) const;
+    QList<DatabaseManager::TimerRecord> findAfterId(int id) const;
+    QList<DatabaseManager::DailyGoalTotal> findDailyTotals(const QDate& startDate, const QDate& endDate) const;
+    QMap<int, DatabaseManager::GoalTimeWindows> sumDailyTotalsByWindow(const QDate& today, const QDate& weekStart,
+                                                                       const QDate& weekEnd) const;
     
     bool clear();
     
 private:
-    DatabaseManager::TimerRecord mapFromQuery(const QSqlQuery& query) const;
-    
     QSqlDatabase& m_database;
+    std::shared_ptr<PreparedStatementCache> m_statements;
 };
 
 #endif // TIMERREPOSITORY_H
\ No newline at end of file
@@ -2,31 +2,40 @@
 #define TODOREPOSITORY_H
 
 #include "database/databasemanager.h"
+#include "database/preparedstatementcache.h"
 #include <QList>
+#include <QMap>
 #include <QSqlDatabase>
 #include <QDate>
+#include <QSqlQuery>
+#include <memory>
 #include <optional>
 
 class TodoRepository {
 public:
     explicit TodoRepository(QSqlDatabase& db);
     
-    bool add(const DatabaseManager::TodoItem& todo);
+    std::optional<int> add(const DatabaseManager::TodoItem& todo);
     bool update(const DatabaseManager::TodoItem& todo);
     bool remove(int id);
     
     std::optional<DatabaseManager::TodoItem> findById(int id) const;
     QList<DatabaseManager::TodoItem> findAll(bool includeCompleted = true) const;
     QList<DatabaseManager::TodoItem> findByDateRange(const QDate& startDate, const QDate& endDate, bool includeCompleted = true) const;
+    QList<DatabaseManager::TodoItem> findMatching(const DatabaseManager::TodoFilter& filter) const;
+    QMap<int, DatabaseManager::TodoCountWindows> countByWindow(const QDate& today, const QDate& weekStart,
+                                                               const QDate& weekEnd) const;
     
     bool toggleCompletion(int id, bool completed);
     bool clear();
     
 private:
-    DatabaseManager::TodoItem mapFromQuery(const QSqlQuery& query) const;
-    bool bindTodoToQuery(QSqlQuery& query, const DatabaseManager::TodoItem& todo) const;
-    
+    // SQL conditions for the parts of filter that narrow anything, and their values in order
+    static QString filterConditions(const DatabaseManager::TodoFilter& filter);
+    static void bindFilter(QSqlQuery& query, const DatabaseManager::TodoFilter& filter);
+
     QSqlDatabase& m_database;
+    std::shared_ptr<PreparedStatementCache> m_statements;
 };
 
 #endif // TODOREPOSITORY_H
\ No newline at end of file
@@ -0,0 +1,194 @@
+#ifndef ROWTRAITS_H
+#define ROWTRAITS_H
+
+#include "database/databasemanager.h"
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariant>
+#include <array>
+
+// One table column of Item. `read` gives the value bound on INSERT and UPDATE,
+// `write` stores a selected value; a column that only goes one way leaves the other null.
+template <typename Item>
+struct ColumnDescriptor {
+    const char* name;
+    QVariant (*read)(const Item&);
+    void (*write)(Item&, const QVariant&);
+};
+
+// Accessors for a data member whose type QVariant converts directly
+template <auto Member>
+struct Field;
+
+template <typename C, typename T, T C::*Member>
+struct Field<Member> {
+    using Item = C;
+
+    static QVariant read(const Item& item) { return QVariant::fromValue(item.*Member); }
+    static void write(Item& item, const QVariant& value) { item.*Member = value.value<T>(); }
+};
+
+template <auto Member>
+constexpr ColumnDescriptor<typename Field<Member>::Item> column(const char* name)
+{
+    return {name, &Field<Member>::read, &Field<Member>::write};
+}
+
+// Specialized for every item type stored in the database, with the table name and
+// its columns. The first column is the primary key.
+template <typename Item>
+struct RowTraits;
+
+template <>
+struct RowTraits<DatabaseManager::GoalItem> {
+    using Item = DatabaseManager::GoalItem;
+
+    static constexpr const char* table = "goals";
+    static constexpr std::array<ColumnDescriptor<Item>, 7> columns = {{
+        column<&Item::id>("id"),
+        column<&Item::title>("title"),
+        column<&Item::description>("description"),
+        column<&Item::isCompleted>("is_completed"),
+        {"priority",
+         [](const Item& goal) { return QVariant(static_cast<int>(goal.priority)); },
+         [](Item& goal, const QVariant& value) { goal.priority = static_cast<DatabaseManager::TodoPriority>(value.toInt()); }},
+        column<&Item::colorCode>("color_code"),
+        column<&Item::estimatedTime>("estimated_time"),
+    }};
+};
+
+template <>
+struct RowTraits<DatabaseManager::TodoItem> {
+    using Item = DatabaseManager::TodoItem;
+
+    static constexpr const char* table = "todos";
+    static constexpr std::array<ColumnDescriptor<Item>, 10> columns = {{
+        column<&Item::id>("id"),
+        // NULL means no goal; anything else must reference an existing goal
+        {"goal_id",
+         [](const Item& todo) { return todo.goalId > 0 ? QVariant(todo.goalId) : QVariant(QVariant::Int); },
+         [](Item& todo, const QVariant& value) { todo.goalId = value.isNull() ? DatabaseManager::NO_GOAL_ID : value.toInt(); }},
+        column<&Item::title>("title"),
+        column<&Item::description>("description"),
+        column<&Item::isCompleted>("is_completed"),
+        {"priority",
+         [](const Item& todo) { return QVariant(static_cast<int>(todo.priority)); },
+         [](Item& todo, const QVariant& value) { todo.priority = static_cast<DatabaseManager::TodoPriority>(value.toInt()); }},
+        column<&Item::colorCode>("color_code"),
+        column<&Item::startDate>("start_date"),
+        column<&Item::endDate>("end_date"),
+        // Maintained by the update_todos_last_update trigger
+        {"last_update", nullptr, &Field<&Item::lastUpdate>::write},
+    }};
+};
+
+template <>
+struct RowTraits<DatabaseManager::TimerRecord> {
+    using Item = DatabaseManager::TimerRecord;
+
+    static constexpr const char* table = "timer_records";
+    static constexpr std::array<ColumnDescriptor<Item>, 5> columns = {{
+        column<&Item::id>("id"),
+        {"goal_id",
+         [](const Item& record) { return record.goalId > 0 ? QVariant(record.goalId) : QVariant(QVariant::Int); },
+         [](Item& record, const QVariant& value) { record.goalId = value.isNull() ? DatabaseManager::NO_GOAL_ID : value.toInt(); }},
+        {"start_time",
+         [](const Item& record) { return QVariant(record.startTime.toSecsSinceEpoch()); },
+         [](Item& record, const QVariant& value) { record.startTime = QDateTime::fromSecsSinceEpoch(value.toLongLong()); }},
+        {"end_time",
+         [](const Item& record) { return QVariant(record.endTime.toSecsSinceEpoch()); },
+         [](Item& record, const QVariant& value) { record.endTime = QDateTime::fromSecsSinceEpoch(value.toLongLong()); }},
+        // Derived from the two timestamps, so only ever written
+        {"duration_seconds",
+         [](const Item& record) { return QVariant(record.endTime.toSecsSinceEpoch() - record.startTime.toSecsSinceEpoch()); },
+         nullptr},
+    }};
+};
+
+// SQL and bindings generated from RowTraits
+namespace RowMapping {
+    // Comma separated names of the columns map() reads, in the order it reads them
+    template <typename Item>
+    const QString& selectList()
+    {
+        static const QString list = [] {
+            QStringList names;
+            for (const auto& column : RowTraits<Item>::columns) {
+                if (column.write) {
+                    names << column.name;
+                }
+            }
+            return names.join(", ");
+        }();
+        return list;
+    }
+
+    // Fills the %1 placeholder of a DatabaseQueries SELECT with selectList()
+    template <typename Item>
+    QString select(const QString& sqlTemplate)
+    {
+        return sqlTemplate.arg(selectList<Item>());
+    }
+
+    template <typename Item>
+    const QString& insertStatement()
+    {
+        static const QString sql = [] {
+            QStringList names;
+            QStringList placeholders;
+            for (std::size_t i = 1; i < RowTraits<Item>::columns.size(); ++i) {
+                if (RowTraits<Item>::columns[i].read) {
+                    names << RowTraits<Item>::columns[i].name;
+                    placeholders << "?";
+                }
+            }
+            return QString("INSERT INTO %1 (%2) VALUES (%3)")
+                .arg(RowTraits<Item>::table, names.join(", "), placeholders.join(", "));
+        }();
+        return sql;
+    }
+
+    // Binds like bind(), followed by the primary key
+    template <typename Item>
+    const QString& updateStatement()
+    {
+        static const QString sql = [] {
+            QStringList assignments;
+            for (std::size_t i = 1; i < RowTraits<Item>::columns.size(); ++i) {
+                if (RowTraits<Item>::columns[i].read) {
+                    assignments << QString("%1 = ?").arg(RowTraits<Item>::columns[i].name);
+                }
+            }
+            return QString("UPDATE %1 SET %2 WHERE %3 = ?")
+                .arg(RowTraits<Item>::table, assignments.join(", "), RowTraits<Item>::columns[0].name);
+        }();
+        return sql;
+    }
+
+    // Binds every writable column except the primary key, in declaration order
+    template <typename Item>
+    void bind(QSqlQuery& query, const Item& item)
+    {
+        for (std::size_t i = 1; i < RowTraits<Item>::columns.size(); ++i) {
+            if (RowTraits<Item>::columns[i].read) {
+                query.addBindValue(RowTraits<Item>::columns[i].read(item));
+            }
+        }
+    }
+
+    // Reads the current row of a query that starts with selectList()
+    template <typename Item>
+    Item map(const QSqlQuery& query)
+    {
+        Item item;
+        int index = 0;
+        for (const auto& column : RowTraits<Item>::columns) {
+            if (column.write) {
+                column.write(item, query.value(index++));
+            }
+        }
+        return item;
+    }
+}
+
+#endif // ROWTRAITS_H
@@ -53,6 +53,8 @@ private slots:
 
     void onEditTodoRequested(int todoId);
 
+    void onDataChanged(const DatabaseManager::ChangeSet& changes);
+
 private:
     // UI setup methods
     void setupUi();
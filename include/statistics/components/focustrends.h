@@ -0,0 +1,83 @@
+#ifndef FOCUSTRENDS_H
+#define FOCUSTRENDS_H
+
+#include <QObject>
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <array>
+#include "database/databasemanager.h"
+
+// Rolling averages, the daily focus streak and per-goal week-over-week totals,
+// kept as running aggregates. History is read once from the daily rollup; after
+// that every stored session is folded in without looking at older days again.
+class FocusTrends : public QObject {
+    Q_OBJECT
+
+public:
+    struct GoalTrend {
+        int goalId = DatabaseManager::NO_GOAL_ID;
+        qint64 thisWeekSeconds = 0;
+        qint64 lastWeekSeconds = 0;
+    };
+
+    struct Summary {
+        bool isLoaded = false;
+        double averageSeconds7 = 0.0;   // Per day, today included
+        double averageSeconds30 = 0.0;
+        int currentStreak = 0;          // Days in a row with focused time, up to today or yesterday
+        int longestStreak = 0;
+        QList<GoalTrend> goalTrends;    // Goals with time in either week, busiest this week first
+    };
+
+    static FocusTrends& instance();
+
+    // Moves the windows on to today first; starts loading on first use
+    Summary summary();
+
+    // Folds a session that was just stored into every aggregate
+    void recordSession(const DatabaseManager::TimerRecord& record);
+
+signals:
+    // History was (re)read from the database
+    void loaded();
+
+private:
+    FocusTrends();
+
+    // Prevent copying
+    FocusTrends(const FocusTrends&) = delete;
+    FocusTrends& operator=(const FocusTrends&) = delete;
+
+    void load();
+    void reset();
+    void onDataChanged(const DatabaseManager::ChangeSet& changes);
+
+    void advanceTo(const QDate& today);
+    void addSeconds(const QDate& day, int goalId, qint64 seconds);
+    qint64& daySeconds(const QDate& day);
+
+    static constexpr int WINDOW_DAYS = 30;
+    static constexpr int SHORT_WINDOW_DAYS = 7;
+
+    bool m_isLoaded;
+    bool m_isLoading;
+    bool m_reloadQueued;
+
+    // Last WINDOW_DAYS days up to m_today, indexed by Julian day
+    QDate m_today;
+    std::array<qint64, WINDOW_DAYS> m_days;
+    qint64 m_shortWindowSeconds;
+    qint64 m_windowSeconds;
+
+    // Days arrive in order, so a streak only ever grows or restarts
+    QDate m_lastActiveDay;
+    int m_streak;  // Ending at m_lastActiveDay
+    int m_longestStreak;
+
+    QDate m_weekStart;  // Monday of m_today's week
+    QHash<int, qint64> m_thisWeek;
+    QHash<int, qint64> m_lastWeek;
+};
+
+#endif // FOCUSTRENDS_H
@@ -0,0 +1,54 @@
+#ifndef INTERVALSPLITTER_H
+#define INTERVALSPLITTER_H
+
+#include <QDate>
+#include <QDateTime>
+#include <QtGlobal>
+
+// Cuts sessions at local time bucket boundaries, so a session running from 23:40
+// to 00:20 counts 20 minutes towards each day. Every day from firstDay on is split
+// into slotsPerDay equal buckets starting at midnight, numbered consecutively.
+class IntervalSplitter {
+public:
+    IntervalSplitter(const QDate& firstDay, int slotsPerDay);
+
+    // Bucket holding time
+    int bucketOf(const QDateTime& time) const;
+
+    // Calls visit(bucket, seconds) for every bucket [start, end) overlaps, in order.
+    // The seconds of all calls add up to the session's duration.
+    template <typename Visitor>
+    void split(const QDateTime& start, const QDateTime& end, Visitor visit) const;
+
+private:
+    // Epoch seconds at which the slot after (day, slot) begins
+    qint64 slotEnd(const QDate& day, int slot) const;
+
+    QDate m_firstDay;
+    int m_slotsPerDay;
+};
+
+template <typename Visitor>
+void IntervalSplitter::split(const QDateTime& start, const QDateTime& end, Visitor visit) const
+{
+    qint64 from = start.toSecsSinceEpoch();
+    const qint64 to = end.toSecsSinceEpoch();
+
+    QDate day = start.date();
+    int slot = start.time().hour() * m_slotsPerDay / 24;
+    int bucket = bucketOf(start);
+
+    while (from < to) {
+        const qint64 pieceEnd = qMin(slotEnd(day, slot), to);
+        visit(bucket, pieceEnd - from);
+        from = pieceEnd;
+
+        ++bucket;
+        if (++slot == m_slotsPerDay) {
+            slot = 0;
+            day = day.addDays(1);
+        }
+    }
+}
+
+#endif // INTERVALSPLITTER_H
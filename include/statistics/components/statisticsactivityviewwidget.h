@@ -0,0 +1,55 @@
+#ifndef STATISTICSACTIVITYVIEWWIDGET_H
+#define STATISTICSACTIVITYVIEWWIDGET_H
+
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QLabel>
+#include <QComboBox>
+#include <QScrollArea>
+#include <QDate>
+#include <QList>
+#include "database/databasemanager.h"
+#include "statistics/components/focustrends.h"
+
+class StatisticsHeatmapWidget;
+
+// Year-long heatmap of focused time, for all goals or the one picked in the header,
+// with rolling averages, the focus streak and this week's trend per goal below it
+class StatisticsActivityViewWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit StatisticsActivityViewWidget(QWidget* parent = nullptr);
+
+    // Rows of the daily rollup for the weeks up to lastDay
+    void setDailyTotals(const QList<DatabaseManager::DailyGoalTotal>& totals, const QDate& lastDay);
+    void setTrends(const FocusTrends::Summary& summary);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private slots:
+    void onGoalSelected();
+
+private:
+    // Combo box entry standing for every goal together
+    static constexpr int ALL_GOALS = -2;
+
+    void setupUi();
+    void updateGoalChoices();
+    void updateHeatmap();
+
+    QVBoxLayout* m_mainLayout;
+    QLabel* m_titleLabel;
+    QComboBox* m_goalComboBox;
+    QLabel* m_summaryLabel;
+    QScrollArea* m_scrollArea;
+    StatisticsHeatmapWidget* m_heatmap;
+    QLabel* m_trendsLabel;
+    QLabel* m_goalTrendsLabel;
+
+    QList<DatabaseManager::DailyGoalTotal> m_totals;
+    QDate m_lastDay;
+};
+
+#endif // STATISTICSACTIVITYVIEWWIDGET_H
@@ -0,0 +1,86 @@
+#ifndef STATISTICSCHARTWIDGET_H
+#define STATISTICSCHARTWIDGET_H
+
+#include <QWidget>
+#include <QColor>
+#include <QList>
+#include <QRect>
+#include <QString>
+#include <QVariantAnimation>
+
+// Lays out and paints every bar of a statistics chart in one widget, so new data
+// replaces the bars in place instead of recreating a widget per bar. Vertical
+// charts stack one segment per goal in each bar, horizontal charts draw one
+// labelled bar per row.
+class StatisticsChartWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    enum class Orientation {
+        Vertical,
+        Horizontal
+    };
+
+    struct Segment {
+        QString label;
+        QString goalTitle;
+        double hours;
+        QColor color;
+        int goalId;
+    };
+
+    struct Bar {
+        QString label;
+        QList<Segment> segments;
+    };
+
+    explicit StatisticsChartWidget(Orientation orientation, QWidget* parent = nullptr);
+
+    // Bars keeping their label grow or shrink from what is shown now
+    void setBars(const QList<Bar>& bars, double maxHours);
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    bool event(QEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void leaveEvent(QEvent* event) override;
+
+private:
+    void paintVerticalBar(QPainter& painter, int index) const;
+    void paintHorizontalBar(QPainter& painter, int index) const;
+    QRect barRect(int index) const;
+    int barAt(const QPoint& pos) const;
+    double displayedHours(int index) const;
+    void setHoveredIndex(int index);
+
+    static double totalHours(const Bar& bar);
+    static QString formatHours(double hours);
+    static bool sameSegments(const QList<Segment>& a, const QList<Segment>& b);
+
+    // Vertical bars
+    static const int BAR_WIDTH = 90;
+    static const int TOTAL_TIME_HEIGHT = 20;
+    static const int DATE_LABEL_HEIGHT = 30;
+
+    // Horizontal bars
+    static const int BAR_HEIGHT = 50;
+    static const int LABEL_WIDTH = 160;
+
+    static const int MARGIN = 8;
+    static const int PADDING = 15;
+
+    Orientation m_orientation;
+    QList<Bar> m_bars;
+    QList<double> m_startHours;  // Per bar, where the animation starts from
+    double m_maxHours;
+    int m_hoveredIndex;
+
+    QVariantAnimation* m_animation;
+    double m_progress;
+    QRect m_animatedRect;  // Bars whose height changes; nothing else is repainted
+};
+
+#endif // STATISTICSCHARTWIDGET_H
@@ -4,13 +4,20 @@
 #include <QObject>
 #include <QDate>
 #include <QTime>
+#include <QCache>
 #include <QColor>
+#include <QHash>
 #include <QList>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QTimer>
 #include "database/databasemanager.h"
-#include "statistics/statisticswidget.h"
+#include "statistics/components/statisticschartwidget.h"
+#include "statistics/components/statisticsindex.h"
+#include "statistics/components/statisticsperiod.h"
+#include "statistics/components/timeraggregation.h"
+#include "statistics/components/timerrecordcolumns.h"
 
 class StatisticsDataManager : public QObject {
     Q_OBJECT
@@ -18,39 +25,112 @@ class StatisticsDataManager : public QObject {
 public:
     explicit StatisticsDataManager(QObject* parent = nullptr);
     
-    void loadTimeBasedStatistics(const QString& rangeType, const QDate& referenceDate);
-    void loadGoalStatistics(const QString& rangeType, const QDate& referenceDate);
+    // Computes both views on a worker thread. Requests made while one is running
+    // replace each other, and only the latest one is emitted
+    void loadStatistics(const StatisticsPeriod& period);
+
+    // Reads only sessions stored since the previous refresh, or everything
+    // again once noteChanges() has seen history being removed or rewritten
     void refreshFromDatabase();
+    void noteChanges(const DatabaseManager::ChangeSet& changes);
+
+    // Per-day totals of the past year, read from the daily rollup table
+    void loadDailyTotals();
+
+    // Ad-hoc filter and group-by over every session, on a worker thread. Only the
+    // latest query is emitted, and it runs again whenever new data is read
+    void runQuery(const TimerAggregation::Query& query);
     
-    QString formatHours(double hours) const;
+    static QString formatHours(double hours);
     double getMaxHours() const { return m_maxHours; }
     double getMaxVerticalHours() const { return m_maxVerticalHours; }
 
 signals:
-    void timeBasedDataLoaded(const QList<QPair<QString, QList<StatisticsVerticalBarWidget::Segment>>>& data, 
+    void timeBasedDataLoaded(const QList<QPair<QString, QList<StatisticsChartWidget::Segment>>>& data, 
                             const QString& summaryText);
     void goalDataLoaded(const QList<QPair<QString, QPair<double, QColor>>>& data, 
                        const QString& summaryText);
     void dataRefreshed();
+    void dailyTotalsLoaded(const QList<DatabaseManager::DailyGoalTotal>& totals, const QDate& lastDay);
+    void busyChanged(bool busy);
+    void queryFinished(const TimerAggregation::Result& result);
 
 private:
-    QString getTimeGroupLabel(const QDate& recordDate, const QString& rangeType,
-                             const QDate& referenceDate) const;
-    QString getTimeGroupLabel(const QDate& recordDate, const QTime& recordTime,
-                             const QString& rangeType, const QDate& referenceDate) const;
-    QColor getColorForTimeGroup(const QString& label, const QString& rangeType,
-                               const QDate& referenceDate) const;
-    QDate getPeriodStartDate(const QString& rangeType, const QDate& referenceDate) const;
-    QDate getPeriodEndDate(const QString& rangeType, const QDate& referenceDate) const;
-    QStringList getExpectedTimeGroups(const QString& rangeType, const QDate& startDate, 
-                                     const QDate& endDate) const;
-
-    QList<DatabaseManager::TimerRecord> m_timerRecords;
+    // One bar of the time based view: whole days, or a single slot of startDate
+    struct TimeGroup {
+        QString label;
+        QDate startDate;
+        QDate endDate;
+        int slot = -1;
+    };
+
+    // What the worker reads; a copy of the GUI thread's state
+    struct Snapshot {
+        StatisticsIndex index;
+        QList<DatabaseManager::GoalItem> goals;
+        QHash<int, DatabaseManager::GoalItem> goalsById;
+    };
+
+    struct Result {
+        QList<QPair<QString, QList<StatisticsChartWidget::Segment>>> timeBasedData;
+        QString timeBasedSummary;
+        double maxVerticalHours = 0.0;
+        QList<QPair<QString, QPair<double, QColor>>> goalData;
+        QString goalSummary;
+        double maxHours = 0.0;
+    };
+
+    // Periods kept by their "start/end" days (see cacheKey()); a week's result is a few kilobytes
+    static constexpr int RESULT_CACHE_SIZE = 24;
+
+    // Enough days for a heatmap of 53 weeks ending today
+    static constexpr int DAILY_TOTALS_DAYS = 53 * 7;
+
+    void reloadGoals();
+    void startComputation();
+    void prefetchNeighbours(const StatisticsPeriod& period);
+    void emitResult(const Result& result);
+    void invalidateCache();
+    void invalidateCache(const QList<DatabaseManager::TimerRecord>& records);
+    static QString cacheKey(const StatisticsPeriod& period);
+    static Result computeStatistics(const Snapshot& snapshot, const StatisticsPeriod& period);
+    static void computeTimeBasedStatistics(const Snapshot& snapshot, const StatisticsPeriod& period,
+                                           Result& result);
+    static void computeGoalStatistics(const Snapshot& snapshot, const StatisticsPeriod& period,
+                                      Result& result);
+    static QList<TimeGroup> getTimeGroups(const StatisticsPeriod& period);
+    template <StatisticsBucketSize Size>
+    static QList<TimeGroup> getBucketGroups(const StatisticsPeriod& period);
+
+    StatisticsIndex m_index;
+    TimerRecordColumns m_columns;
     QList<DatabaseManager::GoalItem> m_goals;
+    QHash<int, DatabaseManager::GoalItem> m_goalsById;
     double m_maxHours;
     double m_maxVerticalHours;
-    
-    QTimer* m_refreshTimer;
+
+    // Highest timer record id folded into m_index
+    int m_lastRecordId;
+    bool m_needsRebuild;
+    bool m_isRefreshing;
+    bool m_refreshQueued;
+    bool m_goalsChanged;
+
+    // Bumped by every loadStatistics() call; results of older generations are dropped
+    StatisticsPeriod m_request;
+    quint64 m_generation;
+    bool m_isComputing;
+
+    // Computed periods, least recently shown evicted first. Results computed
+    // against an older m_cacheVersion are not stored
+    QCache<QString, Result> m_resultCache;
+    QSet<QString> m_prefetching;
+    quint64 m_cacheVersion;
+
+    // Latest ad-hoc query; results of older ones are dropped
+    TimerAggregation::Query m_query;
+    bool m_hasQuery;
+    quint64 m_queryGeneration;
 };
 
 #endif // STATISTICSDATAMANAGER_H
\ No newline at end of file
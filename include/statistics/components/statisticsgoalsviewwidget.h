@@ -6,6 +6,7 @@
 #include <QLabel>
 #include <QScrollArea>
 #include <QColor>
+#include "statistics/components/statisticschartwidget.h"
 
 class StatisticsGoalsViewWidget : public QWidget {
     Q_OBJECT
@@ -13,10 +14,8 @@ class StatisticsGoalsViewWidget : public QWidget {
 public:
     explicit StatisticsGoalsViewWidget(QWidget* parent = nullptr);
     
-    void clearBars();
-    void addBar(const QString& label, double hours, const QColor& color = QColor("#FF6B6B"));
+    void setBars(const QList<QPair<QString, QPair<double, QColor>>>& data, double maxHours);
     void setSummaryText(const QString& text);
-    void setMaxHours(double maxHours) { m_maxHours = maxHours; }
 
 protected:
     void paintEvent(QPaintEvent* event) override;
@@ -28,10 +27,7 @@ private:
     QLabel* m_titleLabel;
     QLabel* m_summaryLabel;
     QScrollArea* m_scrollArea;
-    QWidget* m_barsContainer;
-    QVBoxLayout* m_barsLayout;
-    
-    double m_maxHours;
+    StatisticsChartWidget* m_chart;
 };
 
 #endif // STATISTICSGOALSVIEWWIDGET_H
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include <QMenu>
 #include <QActionGroup>
 #include <QDate>
+#include <QTimer>
+#include "statistics/components/statisticsperiod.h"
 
 class StatisticsHeaderWidget : public QWidget {
     Q_OBJECT
@@ -16,13 +18,16 @@ class StatisticsHeaderWidget : public QWidget {
 public:
     explicit StatisticsHeaderWidget(QWidget* parent = nullptr);
 
-    void setCurrentTimeRange(const QString& range);
-    void setCurrentReferenceDate(const QDate& date);
+    // Switches to the period of rangeType around the current one; Custom asks for the days
+    void setCurrentTimeRange(StatisticsRangeType rangeType);
+    void setCurrentPeriod(const StatisticsPeriod& period);
     void updateNavigationButtons();
     void updatePeriodLabel();
 
-    QString getCurrentTimeRange() const { return m_currentTimeRange; }
-    QDate getCurrentReferenceDate() const { return m_currentReferenceDate; }
+    // Shows the busy indicator once busy has lasted long enough to be noticed
+    void setBusy(bool busy);
+
+    StatisticsPeriod getCurrentPeriod() const { return m_currentPeriod; }
 
     signals:
         void timeRangeChanged();
@@ -41,9 +46,8 @@ private:
     void setupUi();
     void setupTimeRangeMenu();
     void connectSignals();
-    QString getPeriodDisplayName(const QString& rangeType, const QDate& referenceDate) const;
-    QDate getPeriodStartDate(const QString& rangeType, const QDate& referenceDate) const;
-    QDate getPeriodEndDate(const QString& rangeType, const QDate& referenceDate) const;
+    bool pickCustomPeriod();
+    void checkTimeRangeAction(StatisticsRangeType rangeType);
 
     QVBoxLayout* m_mainLayout;
     QHBoxLayout* m_headerLayout;
@@ -56,9 +60,10 @@ private:
     QPushButton* m_todayButton;
     QLabel* m_titleLabel;
     QLabel* m_periodLabel;
+    QLabel* m_busyLabel;
+    QTimer* m_busyTimer;
 
-    QString m_currentTimeRange;
-    QDate m_currentReferenceDate;
+    StatisticsPeriod m_currentPeriod;
 };
 
 #endif // STATISTICSHEADERWIDGET_H
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef STATISTICSHEATMAPWIDGET_H
+#define STATISTICSHEATMAPWIDGET_H
+
+#include <QWidget>
+#include <QColor>
+#include <QDate>
+#include <QMap>
+#include <QPixmap>
+#include <QRect>
+#include <QSet>
+
+// One cell per day for the weeks up to lastDay, shaded by focused time. The grid
+// is painted once into a pixmap; later data only repaints the cells that changed.
+class StatisticsHeatmapWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit StatisticsHeatmapWidget(QWidget* parent = nullptr);
+
+    // Days missing from secondsPerDay had no focused time
+    void setDays(const QMap<QDate, int>& secondsPerDay, const QDate& lastDay, const QColor& color);
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    bool event(QEvent* event) override;
+
+private:
+    void invalidatePixmap();
+    void renderPixmap();
+    void paintCell(QPainter& painter, const QDate& day) const;
+    void paintLabels(QPainter& painter) const;
+
+    QDate firstDay() const;
+    QRect cellRect(const QDate& day) const;
+    QDate dayAt(const QPoint& pos) const;
+    int levelOf(int seconds) const;
+    QColor levelColor(int level) const;
+
+    static constexpr int WEEKS = 53;
+    static constexpr int CELL_SIZE = 11;
+    static constexpr int CELL_SPACING = 3;
+    static constexpr int LEVELS = 4;
+
+    // Room for the month labels above and weekday labels left of the grid
+    static constexpr int TOP_MARGIN = 18;
+    static constexpr int LEFT_MARGIN = 32;
+
+    QMap<QDate, int> m_secondsPerDay;
+    QDate m_lastDay;
+    QColor m_color;
+    int m_maxSeconds;
+
+    QPixmap m_pixmap;
+    bool m_pixmapValid;
+    QSet<QDate> m_dirtyDays;  // Cells to repaint into m_pixmap before it is shown
+};
+
+#endif // STATISTICSHEATMAPWIDGET_H
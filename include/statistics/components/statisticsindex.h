@@ -0,0 +1,68 @@
+#ifndef STATISTICSINDEX_H
+#define STATISTICSINDEX_H
+
+#include "database/databasemanager.h"
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+// Focused time bucketed per goal into 3-hour slots of every day between the first
+// and last recorded session, stored as running sums. Any slot, day or date range
+// total is then the difference of two array entries.
+//
+// A session's time is split across the slots it overlaps, while the session itself
+// counts once, towards the slot it started in.
+class StatisticsIndex {
+public:
+    // 3-hour slots, the finest grouping any statistics view shows
+    static constexpr int SLOTS_PER_DAY = 8;
+    static constexpr int HOURS_PER_SLOT = 24 / SLOTS_PER_DAY;
+
+    void rebuild(const QList<DatabaseManager::TimerRecord>& records);
+
+    // Cheap for sessions near the end of the indexed range, which is where new ones land
+    void addRecord(const DatabaseManager::TimerRecord& record);
+
+    void clear();
+    bool isEmpty() const { return m_slotCount == 0; }
+
+    // Goal ids with at least one session, ascending; NO_GOAL_ID included
+    QList<int> goalIds() const;
+
+    // Time spent within [startDate, endDate] and the sessions started in it
+    qint64 seconds(const QDate& startDate, const QDate& endDate) const;
+    int sessions(const QDate& startDate, const QDate& endDate) const;
+    qint64 goalSeconds(int goalId, const QDate& startDate, const QDate& endDate) const;
+    int goalSessions(int goalId, const QDate& startDate, const QDate& endDate) const;
+
+    // Time spent within one slot of day and the sessions started in it
+    qint64 goalSlotSeconds(int goalId, const QDate& day, int slot) const;
+    int goalSlotSessions(int goalId, const QDate& day, int slot) const;
+
+private:
+    // seconds[i] and sessions[i] hold the totals of slots [0, i)
+    struct Series {
+        QVector<qint64> seconds;
+        QVector<int> sessions;
+    };
+
+    Series& seriesFor(int goalId);
+    static void resizeSeries(Series& series, int slotCount);
+    void coverDay(const QDate& day);
+    void addToSeries(Series& series, int slot, qint64 seconds, int sessions);
+
+    // Slot range [first, last) of the days, clamped to the indexed range
+    QPair<int, int> slotRange(const QDate& startDate, const QDate& endDate) const;
+    QPair<int, int> slotRange(const QDate& day, int slot) const;
+
+    static qint64 secondsBetween(const Series& series, const QPair<int, int>& range);
+    static int sessionsBetween(const Series& series, const QPair<int, int>& range);
+
+    QDate m_firstDay;
+    int m_slotCount = 0;
+    Series m_total;
+    QHash<int, Series> m_goals;
+};
+
+#endif // STATISTICSINDEX_H
@@ -0,0 +1,80 @@
+#ifndef STATISTICSPERIOD_H
+#define STATISTICSPERIOD_H
+
+#include <QDate>
+#include <QString>
+
+enum class StatisticsRangeType {
+    Daily,
+    Weekly,
+    Monthly,
+    Yearly,
+    Custom
+};
+
+// Width of one bar in the time based view
+enum class StatisticsBucketSize {
+    Slot,  // StatisticsIndex::HOURS_PER_SLOT hours
+    Day,
+    Week,
+    Month
+};
+
+// Whole days [startDate, endDate] shown by the statistics page
+struct StatisticsPeriod {
+    StatisticsRangeType rangeType = StatisticsRangeType::Daily;
+    QDate startDate;
+    QDate endDate;
+
+    // The daily, weekly, monthly or yearly period around referenceDate
+    static StatisticsPeriod containing(StatisticsRangeType rangeType, const QDate& referenceDate);
+    static StatisticsPeriod custom(const QDate& startDate, const QDate& endDate);
+    static QString rangeTypeName(StatisticsRangeType rangeType);
+
+    // Monday of date's week; every weekly figure in the app starts here
+    static QDate weekStart(const QDate& date) { return date.addDays(1 - date.dayOfWeek()); }
+
+    // steps periods later, or earlier when negative; custom periods move by their own length
+    StatisticsPeriod shifted(int steps) const;
+
+    bool contains(const QDate& date) const { return date >= startDate && date <= endDate; }
+    qint64 dayCount() const { return startDate.daysTo(endDate) + 1; }
+
+    // Picked from the length alone, so a custom week looks like a weekly period
+    StatisticsBucketSize bucketSize() const;
+    QString displayName() const;
+};
+
+// Compile-time bucket rules for the whole-day bucket sizes: end() is the last day
+// of the bucket containing date, label() names a bucket starting at start
+template <StatisticsBucketSize Size>
+struct StatisticsBucket;
+
+template <>
+struct StatisticsBucket<StatisticsBucketSize::Day> {
+    static QDate end(const QDate& date) { return date; }
+    static QString label(const QDate& start, const StatisticsPeriod& period)
+    {
+        return start.toString(period.dayCount() <= 7 ? "ddd" : "MMM d");
+    }
+};
+
+template <>
+struct StatisticsBucket<StatisticsBucketSize::Week> {
+    static QDate end(const QDate& date) { return date.addDays(7 - date.dayOfWeek()); }
+    static QString label(const QDate& start, const StatisticsPeriod&)
+    {
+        return QString("Week %1").arg(start.weekNumber());
+    }
+};
+
+template <>
+struct StatisticsBucket<StatisticsBucketSize::Month> {
+    static QDate end(const QDate& date) { return QDate(date.year(), date.month(), date.daysInMonth()); }
+    static QString label(const QDate& start, const StatisticsPeriod& period)
+    {
+        return start.toString(period.startDate.year() == period.endDate.year() ? "MMM" : "MMM yyyy");
+    }
+};
+
+#endif // STATISTICSPERIOD_H
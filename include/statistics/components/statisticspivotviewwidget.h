@@ -0,0 +1,65 @@
+#ifndef STATISTICSPIVOTVIEWWIDGET_H
+#define STATISTICSPIVOTVIEWWIDGET_H
+
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QLabel>
+#include <QComboBox>
+#include <QDateEdit>
+#include <QSpinBox>
+#include <QTableWidget>
+#include "statistics/components/timeraggregation.h"
+
+// Pivot table over every session: pick what goes in rows and columns, narrow the
+// sessions down by date, goal and length, and show hours, sessions or average length
+class StatisticsPivotViewWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit StatisticsPivotViewWidget(QWidget* parent = nullptr);
+
+    TimerAggregation::Query query() const;
+    void setResult(const TimerAggregation::Result& result);
+
+signals:
+    void queryChanged(const TimerAggregation::Query& query);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private slots:
+    void onQueryControlsChanged();
+
+private:
+    enum class Measure {
+        Hours,
+        Sessions,
+        AverageMinutes
+    };
+
+    // Goal combo box entry standing for every goal together
+    static constexpr int ALL_GOALS = -2;
+
+    void setupUi();
+    void updateGoalChoices();
+    void updateTable();
+    QString keyLabel(TimerAggregation::Dimension dimension, int key) const;
+    QString cellText(const TimerAggregation::Cell& cell) const;
+    static QComboBox* createDimensionComboBox(QWidget* parent);
+
+    QVBoxLayout* m_mainLayout;
+    QLabel* m_titleLabel;
+    QLabel* m_summaryLabel;
+    QComboBox* m_rowsComboBox;
+    QComboBox* m_columnsComboBox;
+    QComboBox* m_measureComboBox;
+    QComboBox* m_goalComboBox;
+    QDateEdit* m_startDateEdit;
+    QDateEdit* m_endDateEdit;
+    QSpinBox* m_minDurationSpinBox;
+    QTableWidget* m_table;
+
+    TimerAggregation::Result m_result;
+};
+
+#endif // STATISTICSPIVOTVIEWWIDGET_H
@@ -7,7 +7,7 @@
 #include <QLabel>
 #include <QScrollArea>
 #include <QList>
-#include "statistics/statisticswidget.h"
+#include "statistics/components/statisticschartwidget.h"
 
 class StatisticsTimelyViewWidget : public QWidget {
     Q_OBJECT
@@ -15,11 +15,8 @@ class StatisticsTimelyViewWidget : public QWidget {
 public:
     explicit StatisticsTimelyViewWidget(QWidget* parent = nullptr);
     
-    void clearVerticalBars();
-    void addVerticalBar(const QString& label, double maxHours, 
-                       const QList<StatisticsVerticalBarWidget::Segment>& segments);
+    void setBars(const QList<QPair<QString, QList<StatisticsChartWidget::Segment>>>& data, double maxHours);
     void setSummaryText(const QString& text);
-    void setMaxVerticalHours(double maxHours) { m_maxVerticalHours = maxHours; }
 
 protected:
     void paintEvent(QPaintEvent* event) override;
@@ -31,10 +28,7 @@ private:
     QLabel* m_titleLabel;
     QLabel* m_summaryLabel;
     QScrollArea* m_scrollArea;
-    QWidget* m_verticalBarsContainer;
-    QHBoxLayout* m_verticalBarsLayout;
-    
-    double m_maxVerticalHours;
+    StatisticsChartWidget* m_chart;
 };
 
 #endif // STATISTICSTIMELYVIEWWIDGET_H
\ No newline at end of file
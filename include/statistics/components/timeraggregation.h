@@ -0,0 +1,68 @@
+#ifndef TIMERAGGREGATION_H
+#define TIMERAGGREGATION_H
+
+#include "statistics/components/timerrecordcolumns.h"
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QSet>
+
+// Filter and group-by over a TimerRecordColumns snapshot. The records are split
+// into chunks reduced in parallel on the global thread pool, then merged.
+//
+// Sessions are grouped by where they started, with their whole length.
+class TimerAggregation {
+public:
+    enum class Dimension {
+        None,
+        Goal,
+        Year,
+        Month,    // 1 - 12, of any year
+        Weekday,  // 1 = Monday, like QDate::dayOfWeek()
+        Hour      // 0 - 23
+    };
+
+    struct Filter {
+        QDate startDate;  // Local start days, inclusive; invalid means unbounded
+        QDate endDate;
+        int minDurationSeconds = 0;
+        QSet<int> goalIds;  // Empty means every goal
+    };
+
+    struct Query {
+        Filter filter;
+        Dimension rows = Dimension::Weekday;
+        Dimension columns = Dimension::Goal;
+    };
+
+    struct Cell {
+        qint64 seconds = 0;
+        int sessions = 0;
+    };
+
+    struct Result {
+        Query query;
+        QList<int> rowKeys;     // Ascending, only keys with sessions
+        QList<int> columnKeys;
+        QHash<QPair<int, int>, Cell> cells;
+        QHash<int, Cell> rowTotals;
+        QHash<int, Cell> columnTotals;
+        Cell total;
+    };
+
+    // Blocks until every chunk is reduced; meant to run off the GUI thread
+    static Result run(const TimerRecordColumns& columns, const Query& query);
+
+private:
+    using Partial = QHash<quint64, Cell>;
+
+    // Chunks smaller than this cost more to schedule than to scan
+    static constexpr int MIN_CHUNK_SIZE = 16384;
+    static constexpr int CHUNKS_PER_THREAD = 4;
+
+    static Partial reduceChunk(const TimerRecordColumns& columns, const Query& query, int begin, int end);
+    static int keyOf(Dimension dimension, const TimerRecordColumns& columns, int index);
+};
+
+#endif // TIMERAGGREGATION_H
@@ -0,0 +1,43 @@
+#ifndef TIMERRECORDCOLUMNS_H
+#define TIMERRECORDCOLUMNS_H
+
+#include "database/databasemanager.h"
+#include <QList>
+#include <QVector>
+
+// Timer records stored column by column as plain integers, so ad-hoc queries scan
+// a few flat arrays instead of a list of records holding two QDateTimes each.
+// Local-time columns are derived once, when a record is added, never per query.
+//
+// Copies share their arrays until one of them is modified, which makes handing
+// a snapshot to worker threads cheap.
+class TimerRecordColumns {
+public:
+    void rebuild(const QList<DatabaseManager::TimerRecord>& records);
+    void append(const QList<DatabaseManager::TimerRecord>& records);
+    void clear();
+
+    int size() const { return m_startTimes.size(); }
+    bool isEmpty() const { return m_startTimes.isEmpty(); }
+
+    // Epoch seconds and lengths as stored in timer_records
+    const QVector<qint64>& startTimes() const { return m_startTimes; }
+    const QVector<qint32>& durations() const { return m_durations; }
+    const QVector<qint32>& goalIds() const { return m_goalIds; }
+
+    // Where each session started on the local clock: Julian day, year * 12 + month - 1,
+    // and seconds since local midnight
+    const QVector<qint32>& localDays() const { return m_localDays; }
+    const QVector<qint32>& localMonths() const { return m_localMonths; }
+    const QVector<qint32>& localSeconds() const { return m_localSeconds; }
+
+private:
+    QVector<qint64> m_startTimes;
+    QVector<qint32> m_durations;
+    QVector<qint32> m_goalIds;
+    QVector<qint32> m_localDays;
+    QVector<qint32> m_localMonths;
+    QVector<qint32> m_localSeconds;
+};
+
+#endif // TIMERRECORDCOLUMNS_H
@@ -4,6 +4,8 @@
 #include "calendar/components/coloreditemdelegate.h"
 #include "calendar/components/calendarstyles.h"
 #include "calendar/components/calendarutils.h"
+#include "database/databaseexecutor.h"
+#include "common/refreshscheduler.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -11,6 +13,7 @@
 #include <QFont>
 #include <QTime>
 #include <QDate>
+#include <limits>
 
 const QString CalendarWidget::NO_GOAL_TITLE = "No Goal";
 const QString CalendarWidget::NO_GOAL_COLOR = "#C0C0C0";
@@ -28,7 +31,6 @@ CalendarWidget::CalendarWidget(QWidget* parent)
 {
     setupUi();
     updateCalendar();
-    refreshFromDatabase();
 }
 
 void CalendarWidget::setupUi()
@@ -184,6 +186,13 @@ void CalendarWidget::connectSignals()
     connect(m_calendar, &QCalendarWidget::selectionChanged, this, [this]() {
         onDateSelected(m_calendar->selectedDate());
     });
+
+    connect(&DatabaseManager::instance(), &DatabaseManager::dataChanged,
+            this, &CalendarWidget::onDataChanged);
+
+    RefreshScheduler::instance().addPage(this, [this]() {
+        refreshFromDatabase();
+    });
 }
 
 void CalendarWidget::updateDateDetails(const QDate& date)
@@ -191,10 +200,8 @@ void CalendarWidget::updateDateDetails(const QDate& date)
     m_selectedDateLabel->setText(CalendarUtils::formatDate(date));
 
     int totalSeconds = 0;
-    for (const auto& record : m_timerRecords) {
-        if (record.startTime.date() == date) {
-            totalSeconds += record.startTime.secsTo(record.endTime);
-        }
+    for (auto it = goalTimeBegin(date); it != m_goalTimePerDay.constEnd() && it.key().first == date; ++it) {
+        totalSeconds += it.value();
     }
 
     m_totalTimeLabel->setText(QString("Total time: %1")
@@ -224,13 +231,10 @@ void CalendarWidget::addGoalSummariesToList(const QDate& date)
     QMap<int, DatabaseManager::GoalItem> goalInfo;
 
     // Calculate goal time for the date
-    for (const auto& record : m_timerRecords) {
-        if (record.startTime.date() == date) {
-            goalTotalTime[record.goalId] += record.startTime.secsTo(record.endTime);
-            if (goalInfo.find(record.goalId) == goalInfo.end()) {
-                goalInfo[record.goalId] = DatabaseManager::instance().getGoal(record.goalId);
-            }
-        }
+    for (auto it = goalTimeBegin(date); it != m_goalTimePerDay.constEnd() && it.key().first == date; ++it) {
+        const int goalId = it.key().second;
+        goalTotalTime[goalId] = it.value();
+        goalInfo[goalId] = DatabaseManager::instance().getGoal(goalId);
     }
 
     if (!goalTotalTime.isEmpty()) {
@@ -311,31 +315,39 @@ void CalendarWidget::updateCalendar()
     updateCalendarWithTodoData();
 }
 
+void CalendarWidget::updateGoalTimePerDay(const QList<DatabaseManager::DailyGoalTotal>& totals)
+{
+    m_goalTimePerDay.clear();
+
+    // The rollup already splits sessions crossing midnight between both days
+    for (const auto& total : totals) {
+        m_goalTimePerDay.insert(qMakePair(total.day, total.goalId), total.seconds);
+    }
+}
+
+QMap<QPair<QDate, int>, int>::const_iterator CalendarWidget::goalTimeBegin(const QDate& date) const
+{
+    return m_goalTimePerDay.lowerBound(qMakePair(date, std::numeric_limits<int>::min()));
+}
+
 void CalendarWidget::updateCalendarWithGoalData()
 {
     QMap<QDate, QList<GoalTimeInfo>> dateGoalActivities;
-    QMap<QPair<QDate, int>, int> goalTimePerDay;
-
-    // Calculate goal time per day
-    for (const auto& record : m_timerRecords) {
-        QDate recordDate = record.startTime.date();
-        int duration = record.startTime.secsTo(record.endTime);
-        QPair<QDate, int> key(recordDate, record.goalId);
-        goalTimePerDay[key] += duration;
-    }
 
     // Create goal time info for calendar
-    for (auto it = goalTimePerDay.constBegin(); it != goalTimePerDay.constEnd(); ++it) {
+    for (auto it = m_goalTimePerDay.constBegin(); it != m_goalTimePerDay.constEnd(); ++it) {
         QDate date = it.key().first;
         int goalId = it.key().second;
         int totalSeconds = it.value();
 
-        DatabaseManager::GoalItem goal = DatabaseManager::instance().getGoal(goalId);
+        // Cached lookups; no database access per (day, goal) pair
+        DatabaseManager& db = DatabaseManager::instance();
+        DatabaseManager::GoalItem goal = db.getGoal(goalId);
 
         GoalTimeInfo goalInfo;
         goalInfo.goalId = goalId;
         goalInfo.goalTitle = goal.id != -1 ? goal.title : NO_GOAL_TITLE;
-        goalInfo.goalColor = QColor(goal.id != -1 ? goal.colorCode : NO_GOAL_COLOR);
+        goalInfo.goalColor = goal.id != -1 ? db.getGoalColor(goalId) : QColor(NO_GOAL_COLOR);
         goalInfo.minutes = totalSeconds / 60;
 
         dateGoalActivities[date].append(goalInfo);
@@ -419,18 +431,34 @@ void CalendarWidget::onYearSelected(int year)
     navigateToDate(newDate);
 }
 
+void CalendarWidget::onDataChanged(const DatabaseManager::ChangeSet& changes)
+{
+    // Reloaded now if on screen, otherwise when next switched to
+    if (changes.affects(DatabaseManager::Entity::TimerRecord) ||
+        changes.affects(DatabaseManager::Entity::Todo) ||
+        changes.affects(DatabaseManager::Entity::Goal)) {
+        RefreshScheduler::instance().invalidate(this);
+    }
+}
+
 void CalendarWidget::refreshFromDatabase()
 {
     QDate startOfMonth = m_calendar->selectedDate();
     startOfMonth = QDate(startOfMonth.year(), startOfMonth.month(), 1);
     QDate endOfMonth = startOfMonth.addMonths(1).addDays(-1);
 
-    QDateTime startDateTime(startOfMonth, QTime(0, 0, 0));
-    QDateTime endDateTime(endOfMonth, QTime(23, 59, 59));
+    // Both reads run on the executor; the month on screen stays until they finish.
+    // Day totals come from the daily rollup, so no session rows are read
+    auto& executor = DatabaseExecutor::instance();
+    const auto totals = executor.getDailyGoalTotals(startOfMonth, endOfMonth);
+    const auto todos = executor.getAllTodos(true);
 
-    m_timerRecords = DatabaseManager::instance().getTimerRecords(startDateTime, endDateTime);
-    m_todos = DatabaseManager::instance().getAllTodos(true);
+    DatabaseExecutor::deliver(todos, this, [this, totals](const QList<DatabaseManager::TodoItem>& todos) {
+        // Executor jobs run in order, so the totals are already available
+        updateGoalTimePerDay(totals.result());
+        m_todos = todos;
 
-    updateCalendar();
-    updateDateDetails(m_calendar->selectedDate());
+        updateCalendar();
+        updateDateDetails(m_calendar->selectedDate());
+    });
 }
\ No newline at end of file
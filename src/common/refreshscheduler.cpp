@@ -0,0 +1,128 @@
+#include "common/refreshscheduler.h"
+
+#include <QDateTime>
+#include <QEvent>
+#include <QWidget>
+
+RefreshScheduler& RefreshScheduler::instance()
+{
+    static RefreshScheduler instance;
+    return instance;
+}
+
+RefreshScheduler::RefreshScheduler()
+    : QObject()
+{
+    m_midnightTimer.setSingleShot(true);
+    m_midnightTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_midnightTimer, &QTimer::timeout, this, &RefreshScheduler::onMidnight);
+    scheduleMidnight();
+}
+
+void RefreshScheduler::addPage(QWidget* page, std::function<void()> refresh)
+{
+    if (!page || m_pages.contains(page)) {
+        return;
+    }
+
+    Page entry;
+    entry.refresh = std::move(refresh);
+    m_pages.insert(page, entry);
+
+    page->installEventFilter(this);
+    connect(page, &QObject::destroyed, this, [this, page]() {
+        m_pages.remove(page);
+    });
+}
+
+void RefreshScheduler::invalidate(QWidget* page)
+{
+    auto it = m_pages.find(page);
+    if (it == m_pages.end()) {
+        return;
+    }
+
+    it->isDirty = true;
+    if (page->isVisible()) {
+        schedule(page);
+    }
+}
+
+void RefreshScheduler::invalidateAll()
+{
+    for (auto it = m_pages.begin(); it != m_pages.end(); ++it) {
+        it->isDirty = true;
+        if (it.key()->isVisible()) {
+            schedule(it.key());
+        }
+    }
+}
+
+bool RefreshScheduler::eventFilter(QObject* watched, QEvent* event)
+{
+    if (event->type() == QEvent::Show) {
+        QWidget* page = static_cast<QWidget*>(watched);
+        auto it = m_pages.constFind(page);
+        if (it != m_pages.constEnd() && it->isDirty) {
+            schedule(page);
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void RefreshScheduler::schedule(QWidget* page)
+{
+    Page& entry = m_pages[page];
+    if (entry.isScheduled) {
+        return;
+    }
+
+    entry.isScheduled = true;
+    QTimer::singleShot(0, this, [this, page]() {
+        runRefresh(page);
+    });
+}
+
+void RefreshScheduler::runRefresh(QWidget* page)
+{
+    // The page may have been destroyed or switched away from in the meantime
+    auto it = m_pages.find(page);
+    if (it == m_pages.end()) {
+        return;
+    }
+
+    it->isScheduled = false;
+    if (!it->isDirty || !page->isVisible()) {
+        return;
+    }
+
+    it->isDirty = false;
+    const std::function<void()> refresh = it->refresh;
+    refresh();
+}
+
+void RefreshScheduler::scheduleMidnight()
+{
+    m_today = QDate::currentDate();
+    m_midnightTimer.start(msecsToMidnight());
+}
+
+int RefreshScheduler::msecsToMidnight() const
+{
+    // Where daylight saving starts at midnight the day begins at 01:00 instead
+    const QDateTime midnight = m_today.addDays(1).startOfDay();
+    return static_cast<int>(qMax<qint64>(QDateTime::currentDateTime().msecsTo(midnight), 0)) + 1;
+}
+
+void RefreshScheduler::onMidnight()
+{
+    // Precise timers can still wake a little early; wait out the rest of the day
+    if (QDate::currentDate() == m_today) {
+        m_midnightTimer.start(msecsToMidnight());
+        return;
+    }
+
+    scheduleMidnight();
+    invalidateAll();
+    emit dayChanged();
+}
@@ -1,15 +1,14 @@
 #include "dashboard/basedashboardwidget.h"
 #include "dashboard/counterwidget.h"
+#include "dashboard/todolistmodel.h"
+#include "database/databaseexecutor.h"
+#include "common/refreshscheduler.h"
 #include "../../include/dialogs/todo/tododialog.h"
 
-#include <QShowEvent>
 #include <QLabel>
-#include <QListWidget>
-#include <QScrollArea>
+#include <QListView>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QTimer>
-#include <QListWidgetItem>
 #include <QContextMenuEvent>
 #include <QMenu>
 #include <QAction>
@@ -20,7 +19,6 @@
 namespace DashboardConstants {
     constexpr int LIST_UPDATE_BATCH_SIZE = 100;
     constexpr int PROGRESS_UPDATE_THRESHOLD = 5;
-    constexpr int MAX_TODO_DISPLAY_LENGTH = 80;
 
     const QDate EARLIEST_DATE(2000, 1, 1);
     const QDate LATEST_DATE(2100, 12, 31);
@@ -122,12 +120,11 @@ BaseDashboardWidget::BaseDashboardWidget(QWidget* parent)
     , m_statsLayout(nullptr)
     , m_pendingTodosHeaderLayout(nullptr)
     , m_pendingTodosListLabel(nullptr)
-    , m_pendingTodosScrollArea(nullptr)
     , m_pendingTodosList(nullptr)
+    , m_pendingTodosModel(nullptr)
     , m_completedTodosListLabel(nullptr)
-    , m_completedTodosScrollArea(nullptr)
     , m_completedTodosList(nullptr)
-    , m_refreshTimer(nullptr)
+    , m_completedTodosModel(nullptr)
     , m_pendingTodosCount(0)
     , m_completedTodosCount(0)
     , m_timeSpentSeconds(0)
@@ -136,19 +133,17 @@ BaseDashboardWidget::BaseDashboardWidget(QWidget* parent)
     setupUi();
     connectSignals();
 
-    // Create auto-refresh timer
-    m_refreshTimer = new QTimer(this);
-    m_refreshTimer->setInterval(REFRESH_INTERVAL_MS);
-    connect(m_refreshTimer, &QTimer::timeout, this, &BaseDashboardWidget::refreshFromDatabase);
-    m_refreshTimer->start();
+    // Reloaded when shown after a change or a new day, never on a timer
+    RefreshScheduler& scheduler = RefreshScheduler::instance();
+    scheduler.addPage(this, [this]() {
+        refreshFromDatabase();
+    });
+    connect(&scheduler, &RefreshScheduler::dayChanged, this, &BaseDashboardWidget::updateTitle);
 }
 
 BaseDashboardWidget::~BaseDashboardWidget()
 {
     m_isBeingDestroyed = true;
-    if (m_refreshTimer) {
-        m_refreshTimer->stop();
-    }
 }
 
 void BaseDashboardWidget::setupUi()
@@ -166,26 +161,26 @@ void BaseDashboardWidget::setupUi()
         "   border: none;"
         "   border-radius: 12px;"
         "}"
-        "QListWidget {"
+        "QListView {"
         "   background: rgba(255, 255, 255, 200);"
         "   border: 2px solid #FFE0E0;"
         "   border-radius: 12px;"
         "   outline: none;"
         "}"
-        "QListWidget::item {"
+        "QListView::item {"
         "   background: rgba(255, 255, 255, 150);"
         "   border: 1px solid #FFE8E8;"
         "   border-radius: 8px;"
         "   font-size: 14px;"
         "   color: #2c3e50;"
         "}"
-        "QListWidget::item:hover {"
+        "QListView::item:hover {"
         "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0,"
         "       stop:0 #FFE5E5, stop:1 #FFF0F0);"
         "   border: 1px solid #FFB3B3;"
         "   transform: translateY(-2px);"
         "}"
-        "QListWidget::item:selected {"
+        "QListView::item:selected {"
         "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0,"
         "       stop:0 #FFB3B3, stop:1 #FFCCCC);"
         "   border: 2px solid #FF8A8A;"
@@ -276,14 +271,10 @@ void BaseDashboardWidget::createTodoHeader()
 void BaseDashboardWidget::createTodoLists()
 {
     // Create pending todos list with modern styling
-    m_pendingTodosScrollArea = new QScrollArea(this);
-    m_pendingTodosScrollArea->setWidgetResizable(true);
-    m_pendingTodosScrollArea->setMaximumHeight(250);
-    m_pendingTodosScrollArea->setStyleSheet(
-        "QScrollArea {"
-        "   background: transparent;"
-        "   border: none;"
-        "}"
+    m_pendingTodosModel = new TodoListModel(this);
+    m_pendingTodosList = createTodoList(m_pendingTodosModel);
+    m_pendingTodosList->setMaximumHeight(250);
+    m_pendingTodosList->setStyleSheet(
         "QScrollBar:vertical {"
         "   background: rgba(255, 215, 215, 100);"
         "   width: 12px;"
@@ -308,9 +299,7 @@ void BaseDashboardWidget::createTodoLists()
         "}"
     );
 
-    m_pendingTodosList = new QListWidget(this);
-    m_pendingTodosScrollArea->setWidget(m_pendingTodosList);
-    m_mainLayout->addWidget(m_pendingTodosScrollArea);
+    m_mainLayout->addWidget(m_pendingTodosList);
 
     // Create completed todos section
     m_completedTodosListLabel = new QLabel(this);
@@ -318,14 +307,10 @@ void BaseDashboardWidget::createTodoLists()
     m_mainLayout->addWidget(m_completedTodosListLabel);
 
     // Create completed todos list
-    m_completedTodosScrollArea = new QScrollArea(this);
-    m_completedTodosScrollArea->setWidgetResizable(true);
-    m_completedTodosScrollArea->setMaximumHeight(200);
-    m_completedTodosScrollArea->setStyleSheet(
-        "QScrollArea {"
-        "   background: transparent;"
-        "   border: none;"
-        "}"
+    m_completedTodosModel = new TodoListModel(this);
+    m_completedTodosList = createTodoList(m_completedTodosModel);
+    m_completedTodosList->setMaximumHeight(200);
+    m_completedTodosList->setStyleSheet(
         "QScrollBar:vertical {"
         "   background: rgba(255, 215, 215, 100);"
         "   width: 12px;"
@@ -350,31 +335,40 @@ void BaseDashboardWidget::createTodoLists()
         "}"
     );
 
-    m_completedTodosList = new QListWidget(this);
-    m_completedTodosScrollArea->setWidget(m_completedTodosList);
-    m_mainLayout->addWidget(m_completedTodosScrollArea);
+    m_mainLayout->addWidget(m_completedTodosList);
+}
+
+QListView* BaseDashboardWidget::createTodoList(TodoListModel* model)
+{
+    QListView* listView = new QListView(this);
+    listView->setModel(model);
+
+    // Every row is one line with an icon, so the view never measures rows one by one
+    listView->setUniformItemSizes(true);
+    listView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    listView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    listView->setContextMenuPolicy(Qt::CustomContextMenu);
+
+    return listView;
 }
 
 void BaseDashboardWidget::connectSignals()
 {
     // Connect todo list signals
-    if (m_pendingTodosList) {
-        connect(m_pendingTodosList, &QListWidget::itemDoubleClicked,
+    for (QListView* listView : {m_pendingTodosList, m_completedTodosList}) {
+        if (!listView) {
+            continue;
+        }
+        connect(listView, &QListView::doubleClicked,
                 this, &BaseDashboardWidget::onTodoItemDoubleClicked);
-
-        m_pendingTodosList->setContextMenuPolicy(Qt::CustomContextMenu);
-        connect(m_pendingTodosList, &QListWidget::customContextMenuRequested,
+        connect(listView, &QListView::customContextMenuRequested,
                 this, &BaseDashboardWidget::onTodoItemRightClicked);
     }
 
-    if (m_completedTodosList) {
-        connect(m_completedTodosList, &QListWidget::itemDoubleClicked,
-                this, &BaseDashboardWidget::onTodoItemDoubleClicked);
-
-        m_completedTodosList->setContextMenuPolicy(Qt::CustomContextMenu);
-        connect(m_completedTodosList, &QListWidget::customContextMenuRequested,
-                this, &BaseDashboardWidget::onTodoItemRightClicked);
-    }
+    connect(&DatabaseManager::instance(), &DatabaseManager::dataChanged,
+            this, &BaseDashboardWidget::onDataChanged);
+    connect(&DashboardSnapshot::instance(), &DashboardSnapshot::updated,
+            this, &BaseDashboardWidget::onSnapshotUpdated);
 }
 
 void BaseDashboardWidget::updateTitle()
@@ -386,69 +380,78 @@ void BaseDashboardWidget::updateTitle()
     m_titleLabel->setText(getWidgetTitle());
 }
 
-void BaseDashboardWidget::showEvent(QShowEvent* event)
+void BaseDashboardWidget::refreshFromDatabase()
 {
-    QWidget::showEvent(event);
-    if (!m_isBeingDestroyed) {
-        QTimer::singleShot(100, this, [this]() {
-            if (!m_isBeingDestroyed) {
-                refreshFromDatabase();
-            }
-        });
+    if (m_isBeingDestroyed) {
+        return;
     }
+
+    updateDateDisplay();
+
+    // Counters come from the shared snapshot; only the lists are read for this page
+    applySnapshot();
+
+    DatabaseExecutor::deliver(DatabaseExecutor::instance().getTodos(getTodoFilter()), this,
+                              [this](const QList<DatabaseManager::TodoItem>& todos) {
+        if (m_isBeingDestroyed) {
+            return;
+        }
+
+        m_filteredTodos = todos;
+        updateTodosList();
+
+        emit databaseUpdated();
+    });
 }
 
-void BaseDashboardWidget::refreshFromDatabase()
+void BaseDashboardWidget::applySnapshot()
 {
     if (m_isBeingDestroyed) {
         return;
     }
 
-    updateDateDisplay();
-    calculateStats();
-    updateTodosList();
+    // Not loaded yet; updated() follows once it is
+    const std::shared_ptr<const DashboardSnapshot::Data> snapshot = DashboardSnapshot::instance().current();
+    if (!snapshot->isLoaded) {
+        return;
+    }
+
+    doCalculateStats(*snapshot);
     updateCounters();
+}
 
-    emit databaseUpdated();
+void BaseDashboardWidget::onSnapshotUpdated()
+{
+    // Redrawing the counters is cheap on screen; hidden pages catch up when shown
+    if (isVisible()) {
+        applySnapshot();
+    } else {
+        RefreshScheduler::instance().invalidate(this);
+    }
 }
 
-void BaseDashboardWidget::updateDateDisplay()
+void BaseDashboardWidget::onDataChanged(const DatabaseManager::ChangeSet& changes)
 {
-    if (m_isBeingDestroyed) {
+    // Sessions only move figures, which arrive with the next snapshot
+    if (m_isBeingDestroyed || changes.affectsOnly(DatabaseManager::Entity::TimerRecord)) {
         return;
     }
-    doUpdateDateDisplay();
+
+    RefreshScheduler::instance().invalidate(this);
 }
 
-void BaseDashboardWidget::calculateStats()
+void BaseDashboardWidget::updateDateDisplay()
 {
     if (m_isBeingDestroyed) {
         return;
     }
-
-    // Get todos using virtual filter
-    const auto allTodos = DatabaseManager::instance().getAllTodos(true);
-    m_filteredTodos.clear();
-    m_pendingTodosCount = 0;
-    m_completedTodosCount = 0;
-
-    for (const auto& todo : allTodos) {
-        if (shouldIncludeTodo(todo)) {
-            m_filteredTodos.append(todo);
-            if (todo.isCompleted) {
-                m_completedTodosCount++;
-            } else {
-                m_pendingTodosCount++;
-            }
-        }
-    }
-
-    doCalculateStats();
+    doUpdateDateDisplay();
 }
 
-bool BaseDashboardWidget::shouldIncludeTodo(const DatabaseManager::TodoItem& todo) const
+
+DatabaseManager::TodoFilter BaseDashboardWidget::getTodoFilter() const
 {
-    return doShouldIncludeTodo(todo);
+    return doGetTodoFilter();
 }
 
 QString BaseDashboardWidget::getWidgetTitle() const
@@ -456,124 +459,98 @@ QString BaseDashboardWidget::getWidgetTitle() const
     return doGetWidgetTitle();
 }
 
-void BaseDashboardWidget::updateCounters()
+void BaseDashboardWidget::createCounters()
 {
-    if (m_isBeingDestroyed || !m_statsLayout) {
-        return;
-    }
-
-    // Clear existing counters
-    QLayoutItem* item;
-    while ((item = m_statsLayout->takeAt(0)) != nullptr) {
-        delete item->widget();
-        delete item;
+    // Definitions only depend on the kind of dashboard, so the widgets are built once
+    QList<CounterDefinition> definitions = {
+        {tr("Time Spent"), "#FF6B7A", [this](int seconds) { return formatTime(seconds); }},
+        {tr("Pending To-dos"), "#FF8A9A", nullptr},
+        {tr("Completed To-dos"), "#27ae60", nullptr},
+        {tr("Timers Completed"), "#3498db", nullptr}
+    };
+    definitions.append(doGetCounterDefinitions());
+
+    for (const auto& definition : definitions) {
+        CounterWidget* counter = new CounterWidget(definition.title, QString(), definition.color, this);
+        if (definition.format) {
+            counter->setFormatter(definition.format);
+        }
+        m_statsLayout->addWidget(counter);
+        m_counters.append(counter);
     }
-
-    // Create modern counter widgets with tomato theme
-    CounterWidget* timeCounter = new CounterWidget(
-        tr("Time Spent"), formatTime(m_timeSpentSeconds), "#FF6B7A", this);
-    CounterWidget* todosCounter = new CounterWidget(
-        tr("Pending To-dos"), QString::number(m_pendingTodosCount), "#FF8A9A", this);
-    CounterWidget* completedCounter = new CounterWidget(
-        tr("Completed To-dos"), QString::number(m_completedTodosCount), "#27ae60", this);
-    CounterWidget* timersCounter = new CounterWidget(
-        tr("Timers Completed"), QString::number(m_timersCompletedCount), "#3498db", this);
-
-    // Add counters with proper spacing
-    m_statsLayout->addWidget(timeCounter);
-    m_statsLayout->addWidget(todosCounter);
-    m_statsLayout->addWidget(completedCounter);
-    m_statsLayout->addWidget(timersCounter);
 }
 
-QListWidgetItem* BaseDashboardWidget::createTodoItem(const DatabaseManager::TodoItem& todo, bool isCompleted)
+void BaseDashboardWidget::updateCounters()
 {
-    if (m_isBeingDestroyed) {
-        return nullptr;
+    if (m_isBeingDestroyed || !m_statsLayout) {
+        return;
     }
 
-    QString displayText = todo.title;
-    if (displayText.length() > DashboardConstants::MAX_TODO_DISPLAY_LENGTH) {
-        displayText = displayText.left(DashboardConstants::MAX_TODO_DISPLAY_LENGTH - 3) + "...";
+    if (m_counters.isEmpty()) {
+        createCounters();
     }
 
-    QListWidgetItem* item = new QListWidgetItem();
+    QList<CounterValue> values;
+    values.append({m_timeSpentSeconds, QString(), QString()});
+    values.append({m_pendingTodosCount, QString(), QString()});
+    values.append({m_completedTodosCount, QString(), QString()});
+    values.append({m_timersCompletedCount, QString(), QString()});
+    values.append(doGetCounterValues());
 
-    // Set item styling based on completion status
-    if (isCompleted) {
-        item->setIcon(QIcon(":/icons/check_circle.png"));
-        item->setText(displayText);
-        item->setToolTip(todo.title + "\n" + todo.description);
+    // Most refreshes leave every number as it was
+    if (values == m_counterValues) {
+        return;
+    }
+    m_counterValues = values;
 
-        // Completed item styling
-        QFont font = item->font();
-        font.setStrikeOut(true);
-        item->setFont(font);
+    for (int i = 0; i < m_counters.size() && i < values.size(); ++i) {
+        CounterWidget* counter = m_counters.at(i);
+        const CounterValue& value = values.at(i);
 
-        item->setForeground(QColor("#7f8c8d"));
-    } else {
-        item->setIcon(QIcon(":/icons/circle.png"));
-        item->setText(displayText);
-        item->setToolTip(todo.title + "\n" + todo.description);
-
-        // Priority-based styling for pending items
-        QColor priorityColor;
-        switch (todo.priority) {
-            case DatabaseManager::TodoPriority::High:
-                priorityColor = QColor("#e74c3c");
-                break;
-            case DatabaseManager::TodoPriority::Medium:
-                priorityColor = QColor("#f39c12");
-                break;
-            case DatabaseManager::TodoPriority::Low:
-                priorityColor = QColor("#27ae60");
-                break;
+        if (value.text.isEmpty()) {
+            counter->setNumber(value.number);
+        } else {
+            counter->updateValue(value.text);
         }
 
-        item->setForeground(priorityColor);
+        if (counter->toolTip() != value.toolTip) {
+            counter->setToolTip(value.toolTip);
+        }
     }
-
-    // Store todo data
-    item->setData(Qt::UserRole, todo.id);
-    item->setData(Qt::UserRole + 1, todo.isCompleted);
-
-    return item;
 }
 
 void BaseDashboardWidget::updateTodosList()
 {
-    if (m_isBeingDestroyed || !m_pendingTodosList || !m_completedTodosList) {
+    if (m_isBeingDestroyed || !m_pendingTodosModel || !m_completedTodosModel) {
         return;
     }
 
-    // Clear lists
-    m_pendingTodosList->clear();
-    m_completedTodosList->clear();
-
-    // Add filtered todos to appropriate lists
+    QList<DatabaseManager::TodoItem> pendingTodos;
+    QList<DatabaseManager::TodoItem> completedTodos;
     for (const auto& todo : m_filteredTodos) {
-        QListWidgetItem* item = createTodoItem(todo, todo.isCompleted);
-        if (item) {
-            if (todo.isCompleted) {
-                m_completedTodosList->addItem(item);
-            } else {
-                m_pendingTodosList->addItem(item);
-            }
+        if (todo.isCompleted) {
+            completedTodos.append(todo);
+        } else {
+            pendingTodos.append(todo);
         }
     }
 
+    // Only rows that actually changed are touched; unchanged lists stay as they are
+    m_pendingTodosModel->setTodos(pendingTodos);
+    m_completedTodosModel->setTodos(completedTodos);
+
     // Update list visibility based on content
-    m_completedTodosScrollArea->setVisible(true);
+    m_completedTodosList->setVisible(true);
     m_completedTodosListLabel->setVisible(true);
 }
 
-void BaseDashboardWidget::onTodoItemDoubleClicked(QListWidgetItem* item)
+void BaseDashboardWidget::onTodoItemDoubleClicked(const QModelIndex& index)
 {
-    if (m_isBeingDestroyed || !item) {
+    if (m_isBeingDestroyed || !index.isValid()) {
         return;
     }
 
-    int todoId = item->data(Qt::UserRole).toInt();
+    int todoId = index.data(TodoListModel::TodoIdRole).toInt();
     if (todoId > 0) {
         emit todoEditRequested(todoId);
     }
@@ -581,18 +558,18 @@ void BaseDashboardWidget::onTodoItemDoubleClicked(QListWidgetItem* item)
 
 void BaseDashboardWidget::onTodoItemRightClicked(const QPoint& pos)
 {
-    QListWidget* listWidget = qobject_cast<QListWidget*>(sender());
-    if (!listWidget || m_isBeingDestroyed) {
+    QListView* listView = qobject_cast<QListView*>(sender());
+    if (!listView || m_isBeingDestroyed) {
         return;
     }
 
-    QListWidgetItem* item = listWidget->itemAt(pos);
-    if (!item) {
+    const QModelIndex index = listView->indexAt(pos);
+    if (!index.isValid()) {
         return;
     }
 
-    int todoId = item->data(Qt::UserRole).toInt();
-    bool isCompleted = item->data(Qt::UserRole + 1).toBool();
+    int todoId = index.data(TodoListModel::TodoIdRole).toInt();
+    bool isCompleted = index.data(TodoListModel::CompletedRole).toBool();
 
     // Create modern context menu
     QMenu contextMenu(this);
@@ -623,7 +600,7 @@ void BaseDashboardWidget::onTodoItemRightClicked(const QPoint& pos)
     QAction* deleteAction = contextMenu.addAction(tr("Delete"));
     deleteAction->setIcon(QIcon(":/icons/delete.png"));
 
-    QAction* selectedAction = contextMenu.exec(listWidget->mapToGlobal(pos));
+    QAction* selectedAction = contextMenu.exec(listView->viewport()->mapToGlobal(pos));
 
     if (selectedAction == editAction) {
         onTodoItemAction(todoId, "edit");
@@ -647,7 +624,6 @@ void BaseDashboardWidget::onTodoItemAction(int todoId, const QString& action)
         onTodoToggled(todoId, !todo.isCompleted);
     } else if (action == "delete") {
         DatabaseManager::instance().deleteTodo(todoId);
-        refreshFromDatabase();
     }
 }
 
@@ -658,7 +634,6 @@ void BaseDashboardWidget::onTodoToggled(int todoId, bool completed)
     }
 
     DatabaseManager::instance().toggleTodoCompletion(todoId, completed);
-    refreshFromDatabase();
 }
 
 void BaseDashboardWidget::onAddTodoClicked()
@@ -681,4 +656,12 @@ QString BaseDashboardWidget::formatTime(int seconds) const
     } else {
         return QString("%1s").arg(seconds);
     }
+}
+
+void BaseDashboardWidget::setFigures(const DashboardSnapshot::Figures& figures)
+{
+    m_timeSpentSeconds = figures.time.seconds;
+    m_timersCompletedCount = figures.time.sessions;
+    m_pendingTodosCount = figures.todos.pending;
+    m_completedTodosCount = figures.todos.completed;
 }
\ No newline at end of file
@@ -13,6 +13,7 @@ const QString CounterWidget::VALUE_STYLE = "color: #2c3e50; font-size: 28px; tex
 
 CounterWidget::CounterWidget(const QString& title, const QString& value, const QString& color, QWidget* parent)
     : QFrame(parent), m_title(title), m_color(color), m_titleLabel(nullptr), m_valueLabel(nullptr)
+    , m_animation(nullptr), m_number(0), m_hasNumber(false)
 {
     setFrameStyle(QFrame::Box);
     setupUi();
@@ -46,6 +47,14 @@ void CounterWidget::setupUi() {
     m_valueLabel->setStyleSheet(VALUE_STYLE);
     m_valueLabel->setAlignment(Qt::AlignCenter);
     layout->addWidget(m_valueLabel);
+
+    // Only the label text changes while counting; no restyling or relayout
+    m_animation = new QVariantAnimation(this);
+    m_animation->setDuration(ANIMATION_DURATION_MS);
+    m_animation->setEasingCurve(QEasingCurve::OutCubic);
+    connect(m_animation, &QVariantAnimation::valueChanged, this, [this](const QVariant& value) {
+        showNumber(value.toInt());
+    });
 }
 
 QString CounterWidget::getStyleForColor(const QString& color) const {
@@ -68,7 +77,50 @@ QString CounterWidget::getStyleForColor(const QString& color) const {
 }
 
 void CounterWidget::updateValue(const QString& value) {
-    if (m_valueLabel) {
+    if (m_animation) {
+        m_animation->stop();
+    }
+    m_hasNumber = false;
+
+    if (m_valueLabel && m_valueLabel->text() != value) {
         m_valueLabel->setText(value);
     }
+}
+
+void CounterWidget::setNumber(int number) {
+    if (m_hasNumber && number == m_number) {
+        return;
+    }
+
+    // Start from wherever a running count has got to
+    const bool isCounting = m_animation->state() == QAbstractAnimation::Running;
+    const int shown = isCounting ? m_animation->currentValue().toInt() : m_number;
+    const bool animate = m_hasNumber && isVisible();
+
+    m_animation->stop();
+    m_number = number;
+    m_hasNumber = true;
+
+    if (!animate) {
+        showNumber(number);
+        return;
+    }
+
+    m_animation->setStartValue(shown);
+    m_animation->setEndValue(number);
+    m_animation->start();
+}
+
+void CounterWidget::setFormatter(std::function<QString(int)> formatter) {
+    m_formatter = std::move(formatter);
+    if (m_hasNumber) {
+        showNumber(m_number);
+    }
+}
+
+void CounterWidget::showNumber(int number) {
+    const QString text = m_formatter ? m_formatter(number) : QString::number(number);
+    if (m_valueLabel->text() != text) {
+        m_valueLabel->setText(text);
+    }
 }
\ No newline at end of file
@@ -20,7 +20,6 @@ DailyDashboardWidget::DailyDashboardWidget(QWidget* parent)
     );
 
     updateTitle();
-    refreshFromDatabase();
 }
 
 void DailyDashboardWidget::doUpdateDateDisplay()
@@ -42,57 +41,24 @@ void DailyDashboardWidget::doUpdateDateDisplay()
     }
 }
 
-void DailyDashboardWidget::doCalculateStats()
+void DailyDashboardWidget::doCalculateStats(const DashboardSnapshot::Data& snapshot)
 {
     if (m_isBeingDestroyed) {
         return;
     }
 
-    const QDate today = QDate::currentDate();
-
-    // Calculate today's time spent across all goals with better performance
-    m_timeSpentSeconds = 0;
-    const auto allGoals = DatabaseManager::instance().getAllGoals(true);
-    for (const auto& goal : allGoals) {
-        m_timeSpentSeconds += DatabaseManager::instance().getGoalTimeSpentInPeriod(
-            goal.id, today, today);
-    }
-
-    // Get today's completed timer sessions efficiently
-    const QDateTime startOfDay(today, QTime(0, 0));
-    const QDateTime endOfDay(today, QTime(23, 59, 59));
-    const auto timerRecords = DatabaseManager::instance().getTimerRecords(startOfDay, endOfDay);
-    m_timersCompletedCount = timerRecords.size();
-
-    // Filter and count today's todos - already done in base class calculateStats()
-    // The base class handles the filtering using shouldIncludeTodo()
+    setFigures(snapshot.today);
 }
 
-bool DailyDashboardWidget::doShouldIncludeTodo(const DatabaseManager::TodoItem& todo) const
+DatabaseManager::TodoFilter DailyDashboardWidget::doGetTodoFilter() const
 {
-    if (m_isBeingDestroyed) {
-        return false;
-    }
-
+    // Todos whose dates include today; undated ones and open-ended ones count too
     const QDate today = QDate::currentDate();
 
-    bool isInDateRange = false;
-
-    if (!todo.startDate.isValid() && !todo.endDate.isValid()) {
-        // No specific dates - consider as general todo for today
-        isInDateRange = true;
-    } else if (todo.startDate.isValid() && !todo.endDate.isValid()) {
-        // Only start date - include if start date is today or before
-        isInDateRange = (todo.startDate <= today);
-    } else if (!todo.startDate.isValid() && todo.endDate.isValid()) {
-        // Only end date - include if end date is today or after
-        isInDateRange = (todo.endDate >= today);
-    } else if (todo.startDate.isValid() && todo.endDate.isValid()) {
-        // Both dates set - include if today is within range
-        isInDateRange = (todo.startDate <= today && today <= todo.endDate);
-    }
-
-    return isInDateRange;
+    DatabaseManager::TodoFilter filter;
+    filter.startDate = today;
+    filter.endDate = today;
+    return filter;
 }
 
 QString DailyDashboardWidget::getOrdinalSuffix(int day) const
@@ -0,0 +1,168 @@
+#include "dashboard/dashboardsnapshot.h"
+#include "common/refreshscheduler.h"
+#include "statistics/components/statisticsperiod.h"
+
+DashboardSnapshot& DashboardSnapshot::instance()
+{
+    static DashboardSnapshot instance;
+    return instance;
+}
+
+DashboardSnapshot::DashboardSnapshot()
+    : QObject()
+    , m_current(std::make_shared<const Data>())
+    , m_isLoading(false)
+    , m_queuedParts(0)
+    , m_loadedParts(0)
+{
+    connect(&DatabaseManager::instance(), &DatabaseManager::dataChanged,
+            this, &DashboardSnapshot::onDataChanged);
+    connect(&RefreshScheduler::instance(), &RefreshScheduler::dayChanged, this, [this]() {
+        if (m_current->isLoaded || m_isLoading) {
+            load(AllParts);
+        }
+    });
+}
+
+std::shared_ptr<const DashboardSnapshot::Data> DashboardSnapshot::current()
+{
+    if (!m_current->isLoaded && !m_isLoading) {
+        load(AllParts);
+    }
+    return m_current;
+}
+
+void DashboardSnapshot::load(int parts)
+{
+    // A job already queued may have read before the latest write; run once more after it
+    if (m_isLoading) {
+        m_queuedParts |= parts;
+        return;
+    }
+
+    // Rows kept from another day cover the wrong windows
+    const QDate date = QDate::currentDate();
+    if (date != m_date) {
+        parts = AllParts;
+    }
+
+    m_isLoading = true;
+
+    auto future = DatabaseExecutor::instance().run<Reads>([date, parts](DatabaseExecutor::Repositories& repositories) {
+        return read(repositories, date, parts);
+    });
+
+    DatabaseExecutor::deliver(future, this, [this](const Reads& reads) {
+        m_isLoading = false;
+
+        if (reads.date != m_date) {
+            m_date = reads.date;
+            m_loadedParts = 0;
+        }
+        if (reads.parts & Times) {
+            m_times = reads.times;
+        }
+        if (reads.parts & Todos) {
+            m_todoCounts = reads.todoCounts;
+        }
+        m_loadedParts |= reads.parts;
+
+        if (m_queuedParts != 0) {
+            const int queued = m_queuedParts;
+            m_queuedParts = 0;
+            load(queued);
+            return;
+        }
+
+        publish();
+    });
+}
+
+void DashboardSnapshot::onDataChanged(const DatabaseManager::ChangeSet& changes)
+{
+    if (!m_current->isLoaded && !m_isLoading) {
+        return;
+    }
+
+    // Renaming or recoloring a goal moves no figures; removing one detaches its rows
+    int parts = 0;
+    for (const auto& event : changes.events) {
+        switch (event.entity) {
+            case DatabaseManager::Entity::TimerRecord:
+                parts |= Times;
+                break;
+            case DatabaseManager::Entity::Todo:
+                parts |= Todos;
+                break;
+            case DatabaseManager::Entity::Goal:
+                if (event.operation == DatabaseManager::Operation::Removed ||
+                    event.operation == DatabaseManager::Operation::Cleared) {
+                    parts |= AllParts;
+                }
+                break;
+        }
+    }
+
+    if (parts != 0) {
+        load(parts);
+    }
+}
+
+void DashboardSnapshot::publish()
+{
+    if (m_loadedParts != AllParts) {
+        return;
+    }
+
+    Data data;
+    data.isLoaded = true;
+    data.date = m_date;
+    data.weekStart = StatisticsPeriod::weekStart(m_date);
+    data.weekEnd = data.weekStart.addDays(6);
+
+    auto add = [](Figures& figures, const DatabaseManager::GoalTime& time) {
+        figures.time.seconds += time.seconds;
+        figures.time.sessions += time.sessions;
+    };
+    auto count = [](Figures& figures, const DatabaseManager::TodoCounts& todos) {
+        figures.todos.pending += todos.pending;
+        figures.todos.completed += todos.completed;
+    };
+
+    for (auto it = m_times.constBegin(); it != m_times.constEnd(); ++it) {
+        add(data.today, it.value().today);
+        add(data.thisWeek, it.value().week);
+        add(data.allTime, it.value().total);
+        add(data.goals[it.key()], it.value().total);
+    }
+
+    for (auto it = m_todoCounts.constBegin(); it != m_todoCounts.constEnd(); ++it) {
+        count(data.today, it.value().today);
+        count(data.thisWeek, it.value().week);
+        count(data.allTime, it.value().total);
+        count(data.goals[it.key()], it.value().total);
+    }
+
+    m_current = std::make_shared<const Data>(data);
+    emit updated();
+}
+
+DashboardSnapshot::Reads DashboardSnapshot::read(DatabaseExecutor::Repositories& repositories,
+                                                 const QDate& date, int parts)
+{
+    Reads reads;
+    reads.date = date;
+    reads.parts = parts;
+
+    // One grouped query per table; every window is summed from the same rows
+    const QDate first = StatisticsPeriod::weekStart(date);
+    const QDate last = first.addDays(6);
+    if (parts & Times) {
+        reads.times = repositories.timers.sumDailyTotalsByWindow(date, first, last);
+    }
+    if (parts & Todos) {
+        reads.todoCounts = repositories.todos.countByWindow(date, first, last);
+    }
+
+    return reads;
+}
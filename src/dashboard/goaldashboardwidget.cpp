@@ -1,6 +1,7 @@
 #include "dashboard/goaldashboardwidget.h"
 #include "../../include/dialogs/goal/goaldialog.h"
 #include "timer/compacttimerwidget.h"
+#include "common/refreshscheduler.h"
 
 #include <QHBoxLayout>
 #include <QMessageBox>
@@ -336,7 +337,7 @@ void GoalDashboardWidget::setCurrentGoal(int goalId)
         updateGoalInfo();
         updateGoalProgress();
         updateTitle();
-        refreshFromDatabase();
+        RefreshScheduler::instance().invalidate(this);
     }
 }
 
@@ -360,16 +361,6 @@ bool GoalDashboardWidget::canCompleteGoal()
     return !goal.isCompleted;
 }
 
-void GoalDashboardWidget::showEvent(QShowEvent* event)
-{
-    BaseDashboardWidget::showEvent(event);
-
-    if (m_goalId > 0) {
-        updateGoalInfo();
-        updateGoalProgress();
-    }
-}
-
 void GoalDashboardWidget::doUpdateDateDisplay()
 {
     if (m_isBeingDestroyed || !m_dateLabel) {
@@ -380,42 +371,27 @@ void GoalDashboardWidget::doUpdateDateDisplay()
     m_dateLabel->setVisible(false);
 }
 
-void GoalDashboardWidget::doCalculateStats()
+void GoalDashboardWidget::doCalculateStats(const DashboardSnapshot::Data& snapshot)
 {
     if (m_isBeingDestroyed || m_goalId <= 0) {
         return;
     }
 
-    // Calculate time spent on this specific goal
-    const QDate earliestDate(2000, 1, 1);
-    const QDate latestDate(2100, 12, 31);
-    m_timeSpentSeconds = DatabaseManager::instance().getGoalTimeSpentInPeriod(
-        m_goalId, earliestDate, latestDate);
-
-    // Get timer sessions for this goal
-    const QDateTime startDate(earliestDate, QTime(0, 0));
-    const QDateTime endDate(latestDate, QTime(23, 59, 59));
-    const auto allTimerRecords = DatabaseManager::instance().getTimerRecords(startDate, endDate);
-
-    m_timersCompletedCount = 0;
-    for (const auto& record : allTimerRecords) {
-        if (record.goalId == m_goalId) {
-            m_timersCompletedCount++;
-        }
-    }
+    // All-time time, sessions and todos of this goal
+    setFigures(snapshot.goals.value(m_goalId));
 
-    // Update goal progress
+    // Goal lookups hit the cache; re-reading keeps edits made elsewhere in view
+    updateGoalInfo();
     updateGoalProgress();
 }
 
-bool GoalDashboardWidget::doShouldIncludeTodo(const DatabaseManager::TodoItem& todo) const
+DatabaseManager::TodoFilter GoalDashboardWidget::doGetTodoFilter() const
 {
-    if (m_isBeingDestroyed || m_goalId <= 0) {
-        return false;
-    }
-
-    // Include todos that belong to this specific goal
-    return todo.goalId == m_goalId;
+    // Include todos that belong to this specific goal; with no goal selected
+    // the id matches nothing
+    DatabaseManager::TodoFilter filter;
+    filter.goalId = m_goalId;
+    return filter;
 }
 
 QString GoalDashboardWidget::doGetWidgetTitle() const
@@ -432,6 +408,29 @@ QString GoalDashboardWidget::doGetWidgetTitle() const
     return QString("%1").arg(goal.title);
 }
 
+QList<BaseDashboardWidget::CounterDefinition> GoalDashboardWidget::doGetCounterDefinitions() const
+{
+    return {
+        {tr("Time Left"), "#e67e22", [this](int seconds) { return formatTime(seconds); }}
+    };
+}
+
+QList<BaseDashboardWidget::CounterValue> GoalDashboardWidget::doGetCounterValues() const
+{
+    CounterValue timeLeft;
+
+    const DatabaseManager::GoalItem goal = DatabaseManager::instance().getGoal(m_goalId);
+    if (goal.id == -1 || goal.estimatedTime <= 0) {
+        timeLeft.text = "-";
+        timeLeft.toolTip = tr("No time estimate set");
+    } else {
+        timeLeft.number = qMax(0, goal.estimatedTime - m_timeSpentSeconds);
+        timeLeft.toolTip = tr("Estimated: %1").arg(formatTime(goal.estimatedTime));
+    }
+
+    return {timeLeft};
+}
+
 void GoalDashboardWidget::updateGoalInfo()
 {
     if (m_goalId <= 0) {
@@ -577,7 +576,6 @@ void GoalDashboardWidget::onEditGoalClicked()
             updateGoalInfo();
             updateGoalProgress();
             updateTitle();
-            refreshFromDatabase();
 
             // Notify about the update
             emit databaseUpdated();
@@ -602,7 +600,6 @@ void GoalDashboardWidget::onCompleteGoalClicked()
         if (DatabaseManager::instance().completeGoal(m_goalId)) {
             updateGoalInfo();
             updateGoalProgress();
-            refreshFromDatabase();
 
             // Notify about the completion
             emit databaseUpdated();
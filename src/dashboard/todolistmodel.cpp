@@ -0,0 +1,141 @@
+#include "dashboard/todolistmodel.h"
+
+#include <QColor>
+#include <QFont>
+#include <QSet>
+
+TodoListModel::TodoListModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_pendingIcon(":/icons/circle.png")
+    , m_completedIcon(":/icons/check_circle.png")
+{
+}
+
+int TodoListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_todos.size();
+}
+
+QVariant TodoListModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_todos.size()) {
+        return QVariant();
+    }
+
+    const DatabaseManager::TodoItem& todo = m_todos.at(index.row());
+
+    switch (role) {
+    case Qt::DisplayRole:
+        if (todo.title.length() > MAX_DISPLAY_LENGTH) {
+            return todo.title.left(MAX_DISPLAY_LENGTH - 3) + "...";
+        }
+        return todo.title;
+    case Qt::ToolTipRole:
+        return todo.title + "\n" + todo.description;
+    case Qt::DecorationRole:
+        return todo.isCompleted ? m_completedIcon : m_pendingIcon;
+    case Qt::FontRole:
+        if (todo.isCompleted) {
+            QFont font;
+            font.setStrikeOut(true);
+            return font;
+        }
+        return QVariant();
+    case Qt::ForegroundRole:
+        // Completed items are greyed out, pending ones colored by priority
+        if (todo.isCompleted) {
+            return QColor("#7f8c8d");
+        }
+        switch (todo.priority) {
+            case DatabaseManager::TodoPriority::High:
+                return QColor("#e74c3c");
+            case DatabaseManager::TodoPriority::Medium:
+                return QColor("#f39c12");
+            case DatabaseManager::TodoPriority::Low:
+                return QColor("#27ae60");
+        }
+        return QVariant();
+    case TodoIdRole:
+        return todo.id;
+    case CompletedRole:
+        return todo.isCompleted;
+    default:
+        return QVariant();
+    }
+}
+
+void TodoListModel::setTodos(const QList<DatabaseManager::TodoItem>& todos)
+{
+    QSet<int> keptIds;
+    for (const auto& todo : todos) {
+        keptIds.insert(todo.id);
+    }
+
+    // Drop rows that are gone, one run of adjacent rows at a time, from the back
+    for (int row = m_todos.size() - 1; row >= 0; --row) {
+        if (keptIds.contains(m_todos.at(row).id)) {
+            continue;
+        }
+        int first = row;
+        while (first > 0 && !keptIds.contains(m_todos.at(first - 1).id)) {
+            --first;
+        }
+        beginRemoveRows(QModelIndex(), first, row);
+        m_todos.erase(m_todos.begin() + first, m_todos.begin() + row + 1);
+        endRemoveRows();
+        row = first;
+    }
+
+    // Every row left is wanted; bring them into order and insert the new ones
+    for (int row = 0; row < todos.size(); ++row) {
+        const DatabaseManager::TodoItem& todo = todos.at(row);
+
+        if (row < m_todos.size() && m_todos.at(row).id == todo.id) {
+            const bool changed = !isShownAlike(m_todos.at(row), todo);
+            m_todos[row] = todo;
+            if (changed) {
+                const QModelIndex changedIndex = index(row);
+                emit dataChanged(changedIndex, changedIndex);
+            }
+            continue;
+        }
+
+        const int from = rowOf(todo.id, row + 1);
+        if (from < 0) {
+            beginInsertRows(QModelIndex(), row, row);
+            m_todos.insert(row, todo);
+            endInsertRows();
+            continue;
+        }
+
+        // Reordering is rare; the scan above only runs for rows out of place
+        beginMoveRows(QModelIndex(), from, from, QModelIndex(), row);
+        m_todos.move(from, row);
+        endMoveRows();
+
+        const bool changed = !isShownAlike(m_todos.at(row), todo);
+        m_todos[row] = todo;
+        if (changed) {
+            const QModelIndex changedIndex = index(row);
+            emit dataChanged(changedIndex, changedIndex);
+        }
+    }
+}
+
+int TodoListModel::rowOf(int todoId, int from) const
+{
+    for (int row = from; row < m_todos.size(); ++row) {
+        if (m_todos.at(row).id == todoId) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+bool TodoListModel::isShownAlike(const DatabaseManager::TodoItem& a, const DatabaseManager::TodoItem& b)
+{
+    return a.title == b.title &&
+           a.description == b.description &&
+           a.priority == b.priority &&
+           a.isCompleted == b.isCompleted;
+}
@@ -1,8 +1,11 @@
 
 #include "dashboard/totaldashboardwidget.h"
+#include "statistics/components/focustrends.h"
+#include "common/refreshscheduler.h"
 
 #include <QDateTime>
 #include <QTime>
+#include <QStringList>
 
 TotalDashboardWidget::TotalDashboardWidget(QWidget* parent)
     : BaseDashboardWidget(parent)
@@ -18,8 +21,12 @@ TotalDashboardWidget::TotalDashboardWidget(QWidget* parent)
         "}"
     );
 
+    // Trends reread after history changed arrive later than the change itself
+    connect(&FocusTrends::instance(), &FocusTrends::loaded, this, [this]() {
+        RefreshScheduler::instance().invalidate(this);
+    });
+
     updateTitle();
-    refreshFromDatabase();
 }
 
 void TotalDashboardWidget::doUpdateDateDisplay()
@@ -41,46 +48,72 @@ void TotalDashboardWidget::doUpdateDateDisplay()
     }
 }
 
-void TotalDashboardWidget::doCalculateStats()
+void TotalDashboardWidget::doCalculateStats(const DashboardSnapshot::Data& snapshot)
 {
     if (m_isBeingDestroyed) {
         return;
     }
 
-    // Cache database instance to avoid repeated calls
-    DatabaseManager& db = DatabaseManager::instance();
+    setFigures(snapshot.allTime);
+}
 
-    // Calculate total time spent across all goals and all time
-    m_timeSpentSeconds = 0;
-    const auto allGoals = db.getAllGoals(true);
+DatabaseManager::TodoFilter TotalDashboardWidget::doGetTodoFilter() const
+{
+    // For total dashboard, include all todos regardless of dates
+    return DatabaseManager::TodoFilter();
+}
 
-    // Use a very wide date range to capture all historical data
-    const QDate earliestDate(2000, 1, 1);
-    const QDate latestDate(2100, 12, 31);
+QList<BaseDashboardWidget::CounterDefinition> TotalDashboardWidget::doGetCounterDefinitions() const
+{
+    return {
+        {tr("Focus Streak"), "#e67e22", [](int days) { return tr("%1 days").arg(days); }},
+        {tr("Daily Average"), "#9b59b6", [this](int seconds) { return formatTime(seconds); }},
+        {tr("This Week"), "#1abc9c", nullptr}
+    };
+}
 
-    for (const auto& goal : allGoals) {
-        m_timeSpentSeconds += db.getGoalTimeSpentInPeriod(
-            goal.id, earliestDate, latestDate);
+QList<BaseDashboardWidget::CounterValue> TotalDashboardWidget::doGetCounterValues() const
+{
+    const FocusTrends::Summary trends = FocusTrends::instance().summary();
+    if (!trends.isLoaded) {
+        const CounterValue pending{0, "-", QString()};
+        return {pending, pending, pending};
     }
 
-    // Get all completed timer sessions using a very wide date range
-    const QDateTime startDate(earliestDate, QTime(0, 0));
-    const QDateTime endDate(latestDate, QTime(23, 59, 59));
-    const auto allTimerRecords = db.getTimerRecords(startDate, endDate);
-    m_timersCompletedCount = allTimerRecords.size();
-
-    // Filter and count all todos - handled by base class using shouldIncludeTodo()
-    // For total dashboard, we include everything, so shouldIncludeTodo returns true for all
-}
+    CounterValue streak;
+    streak.number = trends.currentStreak;
+    streak.toolTip = tr("Longest streak: %1 days").arg(trends.longestStreak);
+
+    CounterValue average;
+    average.number = qRound(trends.averageSeconds7);
+    average.toolTip = tr("Last 7 days: %1\nLast 30 days: %2")
+                          .arg(formatTime(qRound(trends.averageSeconds7)))
+                          .arg(formatTime(qRound(trends.averageSeconds30)));
+
+    // Week over week for all goals, with each goal's own change in the tooltip
+    qint64 thisWeek = 0;
+    qint64 lastWeek = 0;
+    QStringList goalLines;
+    for (const auto& trend : trends.goalTrends) {
+        thisWeek += trend.thisWeekSeconds;
+        lastWeek += trend.lastWeekSeconds;
+
+        const DatabaseManager::GoalItem goal = DatabaseManager::instance().getGoal(trend.goalId);
+        goalLines << tr("%1: %2 (last week %3)")
+                         .arg(goal.id != -1 ? goal.title : tr("No Goal"))
+                         .arg(formatTime(static_cast<int>(trend.thisWeekSeconds)))
+                         .arg(formatTime(static_cast<int>(trend.lastWeekSeconds)));
+    }
 
-bool TotalDashboardWidget::doShouldIncludeTodo(const DatabaseManager::TodoItem& /*todo*/) const
-{
-    if (m_isBeingDestroyed) {
-        return false;
+    CounterValue week;
+    week.text = tr("new");
+    if (lastWeek > 0) {
+        const int percent = qRound((thisWeek - lastWeek) * 100.0 / lastWeek);
+        week.text = QString("%1%2%").arg(percent >= 0 ? "+" : "").arg(percent);
     }
+    week.toolTip = goalLines.join("\n");
 
-    // For total dashboard, include all todos regardless of dates
-    return true;
+    return {streak, average, week};
 }
 
 QString TotalDashboardWidget::doGetWidgetTitle() const
@@ -1,4 +1,5 @@
 #include "dashboard/weeklydashboardwidget.h"
+#include "statistics/components/statisticsperiod.h"
 
 #include <QDate>
 #include <QDateTime>
@@ -22,16 +23,12 @@ WeeklyDashboardWidget::WeeklyDashboardWidget(QWidget* parent)
 
     updateWeekRange();
     updateTitle();
-    refreshFromDatabase();
 }
 
 void WeeklyDashboardWidget::updateWeekRange()
 {
-    const QDate today = QDate::currentDate();
-
-    // Calculate week start (Monday) and end (Sunday)
-    // Qt's dayOfWeek(): Monday = 1, Sunday = 7
-    m_weekStart = today.addDays(-(today.dayOfWeek() - 1));
+    // Monday to Sunday, the week the snapshot's figures cover
+    m_weekStart = StatisticsPeriod::weekStart(QDate::currentDate());
     m_weekEnd = m_weekStart.addDays(6);
 }
 
@@ -56,58 +53,23 @@ void WeeklyDashboardWidget::doUpdateDateDisplay()
     }
 }
 
-void WeeklyDashboardWidget::doCalculateStats()
+void WeeklyDashboardWidget::doCalculateStats(const DashboardSnapshot::Data& snapshot)
 {
     if (m_isBeingDestroyed) {
         return;
     }
 
-    updateWeekRange();
-
-    // Calculate this week's time spent across all goals
-    m_timeSpentSeconds = 0;
-    const auto allGoals = DatabaseManager::instance().getAllGoals(true);
-    for (const auto& goal : allGoals) {
-        m_timeSpentSeconds += DatabaseManager::instance().getGoalTimeSpentInPeriod(
-            goal.id, m_weekStart, m_weekEnd);
-    }
-
-    // Get this week's completed timer sessions
-    const QDateTime startOfWeek(m_weekStart, QTime(0, 0));
-    const QDateTime endOfWeek(m_weekEnd, QTime(23, 59, 59));
-    const auto timerRecords = DatabaseManager::instance().getTimerRecords(startOfWeek, endOfWeek);
-    m_timersCompletedCount = timerRecords.size();
-
-    // Filter and count this week's todos - handled by base class using shouldIncludeTodo()
+    setFigures(snapshot.thisWeek);
 }
 
-bool WeeklyDashboardWidget::doShouldIncludeTodo(const DatabaseManager::TodoItem& todo) const
+DatabaseManager::TodoFilter WeeklyDashboardWidget::doGetTodoFilter() const
 {
-    if (m_isBeingDestroyed) {
-        return false;
-    }
-
-    // Include todos that overlap with the current week
-    // Week range is already calculated: m_weekStart to m_weekEnd
-
-    bool isInWeekRange = false;
-
-    if (!todo.startDate.isValid() && !todo.endDate.isValid()) {
-        // No specific dates - consider as general todo for current week
-        isInWeekRange = true;
-    } else if (todo.startDate.isValid() && !todo.endDate.isValid()) {
-        // Only start date - include if start date is within or before this week
-        isInWeekRange = (todo.startDate <= m_weekEnd);
-    } else if (!todo.startDate.isValid() && todo.endDate.isValid()) {
-        // Only end date - include if end date is within or after this week
-        isInWeekRange = (todo.endDate >= m_weekStart);
-    } else if (todo.startDate.isValid() && todo.endDate.isValid()) {
-        // Both dates set - include if there's any overlap with this week
-        // Overlap exists if: todo.startDate <= m_weekEnd && todo.endDate >= m_weekStart
-        isInWeekRange = (todo.startDate <= m_weekEnd && todo.endDate >= m_weekStart);
-    }
-
-    return isInWeekRange;
+    // Todos that overlap with the current week; undated ones count too.
+    // The week range is brought up to date by doUpdateDateDisplay()
+    DatabaseManager::TodoFilter filter;
+    filter.startDate = m_weekStart;
+    filter.endDate = m_weekEnd;
+    return filter;
 }
 
 
@@ -129,7 +91,7 @@ QString WeeklyDashboardWidget::doGetWidgetTitle() const
 {
     // Calculate current week range
     const QDate today = QDate::currentDate();
-    QDate weekStart = today.addDays(-(today.dayOfWeek() - 1));
+    QDate weekStart = StatisticsPeriod::weekStart(today);
     QDate weekEnd = weekStart.addDays(6);
 
     // Format the week range display elegantly with ordinal suffixes
@@ -1,5 +1,6 @@
 #include "database/databaseconnectionmanager.h"
 #include "database/databaseconstants.h"
+#include "database/preparedstatementcache.h"
 #include <QCoreApplication>
 #include <QDir>
 #include <QSqlError>
@@ -19,6 +20,7 @@ DatabaseConnectionManager& DatabaseConnectionManager::instance()
 
 DatabaseConnectionManager::DatabaseConnectionManager()
     : m_database(QSqlDatabase::addDatabase(DatabaseConstants::DB_DRIVER))
+    , m_profile(DatabaseConnectionProfile::tuned())
     , m_isInitialized(false)
 {
 }
@@ -45,22 +47,25 @@ bool DatabaseConnectionManager::initialize()
 
 bool DatabaseConnectionManager::setupDatabase()
 {
+    QString dbFilePath = m_databasePath;
+    if (dbFilePath.isEmpty()) {
 #ifdef NDEBUG
-    // Release mode - use installed database path
-    QString dbDir = QDir::homePath() + "/.local/share/tomado/db";
-    QDir dir(dbDir);
-    if (!dir.exists()) {
-        dir.mkpath(".");
-    }
-    QString dbFilePath = dbDir + "/tomado.db";
+        // Release mode - use installed database path
+        QString dbDir = QDir::homePath() + "/.local/share/tomado/db";
+        QDir dir(dbDir);
+        if (!dir.exists()) {
+            dir.mkpath(".");
+        }
+        dbFilePath = dbDir + "/tomado.db";
 #else
-    // Debug mode - use local project database path
-    QString dbFilePath = DB_PATH;
-    QDir dir(QFileInfo(dbFilePath).absolutePath());
-    if (!dir.exists()) {
-        dir.mkpath(".");
-    }
+        // Debug mode - use local project database path
+        dbFilePath = DB_PATH;
+        QDir dir(QFileInfo(dbFilePath).absolutePath());
+        if (!dir.exists()) {
+            dir.mkpath(".");
+        }
 #endif
+    }
 
     m_database.setDatabaseName(dbFilePath);
     
@@ -68,6 +73,12 @@ bool DatabaseConnectionManager::setupDatabase()
         qDebug() << "Failed to open database:" << m_database.lastError().text();
         return false;
     }
+
+    if (!m_profile.apply(m_database)) {
+        qDebug() << "Failed to apply database connection profile";
+        m_database.close();
+        return false;
+    }
     
     return true;
 }
@@ -122,6 +133,7 @@ bool DatabaseConnectionManager::rollbackTransaction()
 void DatabaseConnectionManager::close()
 {
     if (m_database.isOpen()) {
+        PreparedStatementCache::release(m_database);
         m_database.close();
     }
     m_isInitialized = false;
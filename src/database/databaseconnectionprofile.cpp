@@ -0,0 +1,81 @@
+#include "database/databaseconnectionprofile.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+namespace {
+    // PRAGMA statements cannot take bound parameters
+    bool setPragma(QSqlDatabase& db, const QString& name, const QString& value, QString* result = nullptr)
+    {
+        QSqlQuery query(db);
+        if (!query.exec(QString("PRAGMA %1 = %2").arg(name, value))) {
+            qDebug() << "Failed to set PRAGMA" << name << ":" << query.lastError().text();
+            return false;
+        }
+
+        if (result && query.next()) {
+            *result = query.value(0).toString();
+        }
+        return true;
+    }
+}
+
+DatabaseConnectionProfile DatabaseConnectionProfile::legacy()
+{
+    DatabaseConnectionProfile profile;
+    profile.journalMode = "DELETE";
+    profile.synchronous = "FULL";
+    profile.foreignKeys = false;
+    return profile;
+}
+
+DatabaseConnectionProfile DatabaseConnectionProfile::tuned()
+{
+    DatabaseConnectionProfile profile;
+    profile.journalMode = "WAL";
+    profile.synchronous = "NORMAL";
+    profile.cacheSizeKiB = 16 * 1024;
+    profile.mmapSizeBytes = 64 * 1024 * 1024;
+    profile.tempStore = "MEMORY";
+    profile.foreignKeys = true;
+    profile.busyTimeoutMs = 5000;
+    return profile;
+}
+
+bool DatabaseConnectionProfile::apply(QSqlDatabase& db) const
+{
+    // Set first so the journal mode switch below waits for other connections
+    if (busyTimeoutMs > 0 && !setPragma(db, "busy_timeout", QString::number(busyTimeoutMs))) {
+        return false;
+    }
+
+    if (!journalMode.isEmpty()) {
+        // SQLite reports the mode it actually ended up in rather than failing
+        QString mode;
+        if (!setPragma(db, "journal_mode", journalMode, &mode)) {
+            return false;
+        }
+        if (mode.compare(journalMode, Qt::CaseInsensitive) != 0) {
+            qDebug() << "Requested journal mode" << journalMode << "but SQLite is using" << mode;
+        }
+    }
+
+    if (!synchronous.isEmpty() && !setPragma(db, "synchronous", synchronous)) {
+        return false;
+    }
+
+    // Negative cache sizes are in KiB rather than pages
+    if (cacheSizeKiB > 0 && !setPragma(db, "cache_size", QString::number(-cacheSizeKiB))) {
+        return false;
+    }
+
+    if (mmapSizeBytes > 0 && !setPragma(db, "mmap_size", QString::number(mmapSizeBytes))) {
+        return false;
+    }
+
+    if (!tempStore.isEmpty() && !setPragma(db, "temp_store", tempStore)) {
+        return false;
+    }
+
+    return setPragma(db, "foreign_keys", foreignKeys ? "ON" : "OFF");
+}
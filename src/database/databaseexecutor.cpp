@@ -0,0 +1,178 @@
+#include "database/databaseexecutor.h"
+#include "database/databaseconnectionmanager.h"
+#include "database/databaseconstants.h"
+#include "database/preparedstatementcache.h"
+#include <QCoreApplication>
+#include <QSqlError>
+#include <QDebug>
+
+const QString DatabaseExecutor::CONNECTION_NAME = "tomado_executor";
+
+DatabaseExecutor& DatabaseExecutor::instance()
+{
+    static DatabaseExecutor instance;
+    return instance;
+}
+
+DatabaseExecutor::DatabaseExecutor()
+    : QObject()
+    , m_thread(new QThread(this))
+    , m_worker(new QObject())
+    , m_isRunning(false)
+{
+    m_thread->setObjectName("DatabaseExecutor");
+    m_worker->moveToThread(m_thread);
+    connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+}
+
+DatabaseExecutor::~DatabaseExecutor()
+{
+    shutdown();
+}
+
+bool DatabaseExecutor::initialize()
+{
+    if (m_isRunning) {
+        return true;
+    }
+
+    auto& connectionManager = DatabaseConnectionManager::instance();
+    if (!connectionManager.isInitialized()) {
+        return false;
+    }
+
+    const QString databasePath = connectionManager.database().databaseName();
+
+    m_thread->start();
+
+    // The connection has to be created on the thread that will use it
+    bool opened = false;
+    QMetaObject::invokeMethod(m_worker, [this, databasePath, &opened]() {
+        opened = openConnection(databasePath);
+    }, Qt::BlockingQueuedConnection);
+
+    if (!opened) {
+        m_thread->quit();
+        m_thread->wait();
+        return false;
+    }
+
+    m_isRunning = true;
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &DatabaseExecutor::shutdown);
+    return true;
+}
+
+void DatabaseExecutor::shutdown()
+{
+    if (!m_isRunning) {
+        return;
+    }
+
+    // Jobs already queued still run; anything submitted from now on uses the fallback
+    m_isRunning = false;
+    QMetaObject::invokeMethod(m_worker, [this]() {
+        closeConnection();
+    }, Qt::BlockingQueuedConnection);
+
+    m_thread->quit();
+    m_thread->wait();
+}
+
+bool DatabaseExecutor::openConnection(const QString& databasePath)
+{
+    m_database = QSqlDatabase::addDatabase(DatabaseConstants::DB_DRIVER, CONNECTION_NAME);
+    m_database.setDatabaseName(databasePath);
+
+    // Reads only; wait for a writer on the main connection instead of failing
+    m_database.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=5000");
+
+    if (!m_database.open()) {
+        qDebug() << "Failed to open executor database connection:" << m_database.lastError().text();
+        m_database = QSqlDatabase();
+        QSqlDatabase::removeDatabase(CONNECTION_NAME);
+        return false;
+    }
+
+    // Same cache and mmap tuning as the main connection; the journal mode is a
+    // property of the file, which a read-only connection cannot change
+    DatabaseConnectionProfile profile = DatabaseConnectionManager::instance().profile();
+    profile.journalMode.clear();
+    if (!profile.apply(m_database)) {
+        qDebug() << "Failed to apply executor connection profile";
+    }
+
+    m_repositories = std::make_unique<Repositories>(m_database);
+    return true;
+}
+
+void DatabaseExecutor::closeConnection()
+{
+    m_repositories.reset();
+    PreparedStatementCache::release(m_database);
+    m_database.close();
+    m_database = QSqlDatabase();
+    QSqlDatabase::removeDatabase(CONNECTION_NAME);
+}
+
+void DatabaseExecutor::post(std::function<void()> task)
+{
+    QMetaObject::invokeMethod(m_worker, std::move(task), Qt::QueuedConnection);
+}
+
+DatabaseExecutor::Repositories& DatabaseExecutor::fallbackRepositories()
+{
+    if (!m_fallbackRepositories) {
+        m_fallbackRepositories = std::make_unique<Repositories>(DatabaseConnectionManager::instance().database());
+    }
+    return *m_fallbackRepositories;
+}
+
+// Read operations
+QFuture<QList<DatabaseManager::TimerRecord>> DatabaseExecutor::getTimerRecords(const QDateTime& start, const QDateTime& end)
+{
+    return run<QList<DatabaseManager::TimerRecord>>([start, end](Repositories& repositories) {
+        return repositories.timers.findByDateRange(start, end);
+    });
+}
+
+QFuture<QList<DatabaseManager::TimerRecord>> DatabaseExecutor::getTimerRecordsAfter(int id)
+{
+    return run<QList<DatabaseManager::TimerRecord>>([id](Repositories& repositories) {
+        return repositories.timers.findAfterId(id);
+    });
+}
+
+QFuture<QList<DatabaseManager::DailyGoalTotal>> DatabaseExecutor::getDailyGoalTotals(const QDate& startDate, const QDate& endDate)
+{
+    return run<QList<DatabaseManager::DailyGoalTotal>>([startDate, endDate](Repositories& repositories) {
+        return repositories.timers.findDailyTotals(startDate, endDate);
+    });
+}
+
+QFuture<QList<DatabaseManager::TodoItem>> DatabaseExecutor::getAllTodos(bool includeCompleted)
+{
+    return run<QList<DatabaseManager::TodoItem>>([includeCompleted](Repositories& repositories) {
+        return repositories.todos.findAll(includeCompleted);
+    });
+}
+
+QFuture<QList<DatabaseManager::TodoItem>> DatabaseExecutor::getTodos(const DatabaseManager::TodoFilter& filter)
+{
+    return run<QList<DatabaseManager::TodoItem>>([filter](Repositories& repositories) {
+        return repositories.todos.findMatching(filter);
+    });
+}
+
+QFuture<QMap<int, DatabaseManager::GoalTime>> DatabaseExecutor::getTimePerGoal()
+{
+    return run<QMap<int, DatabaseManager::GoalTime>>([](Repositories& repositories) {
+        return repositories.goals.getTimePerGoal();
+    });
+}
+
+QFuture<QMap<int, DatabaseManager::GoalTime>> DatabaseExecutor::getTimePerGoalInPeriod(const QDate& startDate, const QDate& endDate)
+{
+    return run<QMap<int, DatabaseManager::GoalTime>>([startDate, endDate](Repositories& repositories) {
+        return repositories.goals.getTimePerGoalInPeriod(startDate, endDate);
+    });
+}
@@ -2,11 +2,14 @@
 #include "database/databasemanager.h"
 #include "database/databaseconnectionmanager.h"
 #include "database/databaseschemamanager.h"
+#include "database/databaseexecutor.h"
 #include "database/repositories/goalrepository.h"
 #include "database/repositories/todorepository.h"
 #include "database/repositories/timerrepository.h"
 #include "database/services/colorservice.h"
 #include <QDebug>
+#include <QTimer>
+#include <algorithm>
 
 DatabaseManager& DatabaseManager::instance()
 {
@@ -16,6 +19,7 @@ DatabaseManager& DatabaseManager::instance()
 
 DatabaseManager::DatabaseManager()
     : QObject()
+    , m_changeFlushScheduled(false)
     , m_isInitialized(false)
 {
 }
@@ -37,6 +41,12 @@ bool DatabaseManager::initialize()
     }
 
     initializeRepositories();
+
+    // Not fatal: without the worker, asynchronous reads run on the calling thread
+    if (!DatabaseExecutor::instance().initialize()) {
+        qDebug() << "Failed to start database executor";
+    }
+
     m_isInitialized = true;
     return true;
 }
@@ -64,7 +74,16 @@ bool DatabaseManager::setupDatabase()
         return false;
     }
 
-    return DatabaseSchemaManager::verifySchema(db);
+    if (!DatabaseSchemaManager::migrate(db)) {
+        return false;
+    }
+
+    if (!DatabaseSchemaManager::verifySchema(db)) {
+        return false;
+    }
+
+    // Refuse to start rather than silently degrade to full table scans
+    return DatabaseSchemaManager::verifyQueryPlans(db);
 }
 
 void DatabaseManager::initializeRepositories()
@@ -74,11 +93,83 @@ void DatabaseManager::initializeRepositories()
     m_goalRepository = std::make_unique<GoalRepository>(db);
     m_todoRepository = std::make_unique<TodoRepository>(db);
     m_timerRepository = std::make_unique<TimerRepository>(db);
+
+    loadGoalCache();
+}
+
+void DatabaseManager::loadGoalCache()
+{
+    m_goalCache.clear();
+
+    for (const auto& goal : m_goalRepository->findAll(true)) {
+        cacheGoal(goal);
+    }
 }
 
-void DatabaseManager::emitDataChanged()
+void DatabaseManager::cacheGoal(const GoalItem& goal)
 {
-    emit dataChanged();
+    m_goalCache.insert(goal.id, CachedGoal{goal, QColor(goal.colorCode)});
+}
+
+bool DatabaseManager::ChangeSet::affects(Entity entity) const
+{
+    return std::any_of(events.cbegin(), events.cend(), [entity](const ChangeEvent& event) {
+        return event.entity == entity;
+    });
+}
+
+bool DatabaseManager::ChangeSet::affectsOnly(Entity entity) const
+{
+    return !events.isEmpty() &&
+           std::all_of(events.cbegin(), events.cend(), [entity](const ChangeEvent& event) {
+               return event.entity == entity;
+           });
+}
+
+void DatabaseManager::recordChange(Entity entity, Operation operation, int id)
+{
+    QList<ChangeEvent>& events = m_pendingChanges.events;
+
+    if (operation == Operation::Cleared) {
+        // Clearing a table supersedes everything pending for it
+        events.erase(std::remove_if(events.begin(), events.end(), [entity](const ChangeEvent& event) {
+            return event.entity == entity;
+        }), events.end());
+        events.append({entity, operation, id});
+    } else {
+        auto existing = std::find_if(events.begin(), events.end(), [entity, id](const ChangeEvent& event) {
+            return event.entity == entity && event.id == id && event.operation != Operation::Cleared;
+        });
+
+        if (existing == events.end()) {
+            events.append({entity, operation, id});
+        } else if (operation == Operation::Removed) {
+            // Added then removed within the batch: nobody needs to hear about it
+            if (existing->operation == Operation::Added) {
+                events.erase(existing);
+            } else {
+                existing->operation = Operation::Removed;
+            }
+        }
+        // Otherwise the earlier Added/Updated already covers this change
+    }
+
+    if (!m_changeFlushScheduled) {
+        m_changeFlushScheduled = true;
+        QTimer::singleShot(0, this, &DatabaseManager::flushChanges);
+    }
+}
+
+void DatabaseManager::flushChanges()
+{
+    m_changeFlushScheduled = false;
+
+    ChangeSet changes;
+    std::swap(changes, m_pendingChanges);
+
+    if (!changes.isEmpty()) {
+        emit dataChanged(changes);
+    }
 }
 
 // Timer records operations
@@ -88,13 +179,13 @@ bool DatabaseManager::addTimerRecord(const TimerRecord& record) {
         return false;
     }
 
-    bool success = m_timerRepository->add(record);
+    auto id = m_timerRepository->add(record);
 
-    if (success) {
-        emitDataChanged();
+    if (id) {
+        recordChange(Entity::TimerRecord, Operation::Added, *id);
     }
 
-    return success;
+    return id.has_value();
 }
 
 DatabaseManager::TimerRecord DatabaseManager::getTimerRecord(int id)
@@ -132,7 +223,8 @@ bool DatabaseManager::clearTimerRecords()
 
     if (success) {
         connectionManager.commitTransaction();
-        emitDataChanged();
+        // Recorded only once committed, so a rolled back write never notifies
+        recordChange(Entity::TimerRecord, Operation::Cleared);
     } else {
         connectionManager.rollbackTransaction();
     }
@@ -147,11 +239,14 @@ bool DatabaseManager::addGoal(const GoalItem& goal)
         return false;
     }
 
-    bool result = m_goalRepository->add(goal);
-    if (result) {
-        emitDataChanged();
+    auto id = m_goalRepository->add(goal);
+    if (id) {
+        GoalItem added = goal;
+        added.id = *id;
+        cacheGoal(added);
+        recordChange(Entity::Goal, Operation::Added, *id);
     }
-    return result;
+    return id.has_value();
 }
 
 bool DatabaseManager::updateGoal(const GoalItem& goal)
@@ -162,7 +257,8 @@ bool DatabaseManager::updateGoal(const GoalItem& goal)
 
     bool result = m_goalRepository->update(goal);
     if (result) {
-        emitDataChanged();
+        cacheGoal(goal);
+        recordChange(Entity::Goal, Operation::Updated, goal.id);
     }
     return result;
 }
@@ -175,28 +271,37 @@ bool DatabaseManager::deleteGoal(int id)
 
     bool result = m_goalRepository->remove(id);
     if (result) {
-        emitDataChanged();
+        m_goalCache.remove(id);
+        recordChange(Entity::Goal, Operation::Removed, id);
+
+        // Foreign keys delete the goal's todos and detach its timer records
+        recordChange(Entity::Todo, Operation::Removed);
+        recordChange(Entity::TimerRecord, Operation::Updated);
     }
     return result;
 }
 
 DatabaseManager::GoalItem DatabaseManager::getGoal(int id)
 {
-    if (!m_goalRepository) {
-        return GoalItem();
-    }
-
-    auto goal = m_goalRepository->findById(id);
-    return goal.value_or(GoalItem());
+    auto it = m_goalCache.constFind(id);
+    return it != m_goalCache.constEnd() ? it->goal : GoalItem();
 }
 
 QList<DatabaseManager::GoalItem> DatabaseManager::getAllGoals(bool includeCompleted)
 {
-    if (!m_goalRepository) {
-        return QList<GoalItem>();
+    QList<GoalItem> goals;
+    for (const auto& cached : m_goalCache) {
+        if (includeCompleted || !cached.goal.isCompleted) {
+            goals.append(cached.goal);
+        }
     }
 
-    return m_goalRepository->findAll(includeCompleted);
+    // Same order as SELECT_ALL_GOALS: priority descending, then id
+    std::stable_sort(goals.begin(), goals.end(), [](const GoalItem& a, const GoalItem& b) {
+        return static_cast<int>(a.priority) > static_cast<int>(b.priority);
+    });
+
+    return goals;
 }
 
 bool DatabaseManager::toggleGoalCompletion(int id, bool completed)
@@ -207,7 +312,11 @@ bool DatabaseManager::toggleGoalCompletion(int id, bool completed)
 
     bool result = m_goalRepository->toggleCompletion(id, completed);
     if (result) {
-        emitDataChanged();
+        auto it = m_goalCache.find(id);
+        if (it != m_goalCache.end()) {
+            it->goal.isCompleted = completed;
+        }
+        recordChange(Entity::Goal, Operation::Updated, id);
     }
     return result;
 }
@@ -220,11 +329,21 @@ bool DatabaseManager::completeGoal(int goalId)
 
     bool result = m_goalRepository->markAsCompleted(goalId);
     if (result) {
-        emitDataChanged();
+        auto it = m_goalCache.find(goalId);
+        if (it != m_goalCache.end()) {
+            it->goal.isCompleted = true;
+        }
+        recordChange(Entity::Goal, Operation::Updated, goalId);
     }
     return result;
 }
 
+QColor DatabaseManager::getGoalColor(int id) const
+{
+    auto it = m_goalCache.constFind(id);
+    return it != m_goalCache.constEnd() ? it->color : QColor();
+}
+
 int DatabaseManager::getGoalTimeSpent(int goalId)
 {
     if (!m_goalRepository) {
@@ -243,6 +362,24 @@ int DatabaseManager::getGoalTimeSpentInPeriod(int goalId, const QDate& startDate
     return m_goalRepository->getTimeSpentInPeriod(goalId, startDate, endDate);
 }
 
+QMap<int, DatabaseManager::GoalTime> DatabaseManager::getTimePerGoal()
+{
+    if (!m_goalRepository) {
+        return QMap<int, GoalTime>();
+    }
+
+    return m_goalRepository->getTimePerGoal();
+}
+
+QMap<int, DatabaseManager::GoalTime> DatabaseManager::getTimePerGoalInPeriod(const QDate& startDate, const QDate& endDate)
+{
+    if (!m_goalRepository) {
+        return QMap<int, GoalTime>();
+    }
+
+    return m_goalRepository->getTimePerGoalInPeriod(startDate, endDate);
+}
+
 // Todos operations
 bool DatabaseManager::addTodo(const TodoItem& todo)
 {
@@ -250,11 +387,11 @@ bool DatabaseManager::addTodo(const TodoItem& todo)
         return false;
     }
 
-    bool result = m_todoRepository->add(todo);
-    if (result) {
-        emitDataChanged();
+    auto id = m_todoRepository->add(todo);
+    if (id) {
+        recordChange(Entity::Todo, Operation::Added, *id);
     }
-    return result;
+    return id.has_value();
 }
 
 bool DatabaseManager::updateTodo(const TodoItem& todo)
@@ -265,7 +402,7 @@ bool DatabaseManager::updateTodo(const TodoItem& todo)
 
     bool result = m_todoRepository->update(todo);
     if (result) {
-        emitDataChanged();
+        recordChange(Entity::Todo, Operation::Updated, todo.id);
     }
     return result;
 }
@@ -278,7 +415,7 @@ bool DatabaseManager::deleteTodo(int id)
 
     bool result = m_todoRepository->remove(id);
     if (result) {
-        emitDataChanged();
+        recordChange(Entity::Todo, Operation::Removed, id);
     }
     return result;
 }
@@ -310,7 +447,7 @@ bool DatabaseManager::toggleTodoCompletion(int id, bool completed)
 
     bool result = m_todoRepository->toggleCompletion(id, completed);
     if (result) {
-        emitDataChanged();
+        recordChange(Entity::Todo, Operation::Updated, id);
     }
     return result;
 }
@@ -340,7 +477,7 @@ bool DatabaseManager::clearTodos()
 
     if (success) {
         connectionManager.commitTransaction();
-        emitDataChanged();
+        recordChange(Entity::Todo, Operation::Cleared);
     } else {
         connectionManager.rollbackTransaction();
     }
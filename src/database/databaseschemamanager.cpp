@@ -2,6 +2,8 @@
 #include "database/databaseconstants.h"
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QSqlRecord>
+#include <QRegularExpression>
 #include <QDebug>
 
 bool DatabaseSchemaManager::createTables(QSqlDatabase& db)
@@ -16,6 +18,248 @@ bool DatabaseSchemaManager::createTriggers(QSqlDatabase& db)
     return createTodosUpdateTrigger(db);
 }
 
+bool DatabaseSchemaManager::migrate(QSqlDatabase& db)
+{
+    const int currentVersion = schemaVersion(db);
+    if (currentVersion < 0) {
+        return false;
+    }
+
+    if (currentVersion > latestSchemaVersion()) {
+        qWarning() << "Database schema version" << currentVersion
+                   << "is newer than this build supports (" << latestSchemaVersion() << ")";
+        return true;
+    }
+
+    if (currentVersion == latestSchemaVersion()) {
+        return true;
+    }
+
+    // Table rebuilds copy rows that may reference missing goals; SQLite only allows
+    // toggling enforcement outside a transaction, so it is off for the whole run
+    const bool foreignKeys = foreignKeysEnabled(db);
+    if (foreignKeys && !executeQuery(db, "PRAGMA foreign_keys = OFF", "disable foreign keys")) {
+        return false;
+    }
+
+    bool success = true;
+    for (const Migration& migration : migrations()) {
+        if (migration.version <= currentVersion) {
+            continue;
+        }
+
+        if (!applyMigration(db, migration)) {
+            success = false;
+            break;
+        }
+    }
+
+    if (foreignKeys && !executeQuery(db, "PRAGMA foreign_keys = ON", "enable foreign keys")) {
+        return false;
+    }
+
+    return success;
+}
+
+bool DatabaseSchemaManager::foreignKeysEnabled(QSqlDatabase& db)
+{
+    QSqlQuery query(db);
+    return query.exec("PRAGMA foreign_keys") && query.next() && query.value(0).toBool();
+}
+
+int DatabaseSchemaManager::schemaVersion(QSqlDatabase& db)
+{
+    QSqlQuery query(db);
+    if (!query.exec("PRAGMA user_version") || !query.next()) {
+        qDebug() << "Failed to read schema version:" << query.lastError().text();
+        return -1;
+    }
+    return query.value(0).toInt();
+}
+
+int DatabaseSchemaManager::latestSchemaVersion()
+{
+    return migrations().isEmpty() ? 0 : migrations().last().version;
+}
+
+const QList<DatabaseSchemaManager::Migration>& DatabaseSchemaManager::migrations()
+{
+    // Append only: released databases record the last version they applied
+    static const QList<Migration> list = {
+        {1, "index timer records by start time and goal",
+         {DatabaseQueries::CREATE_TIMER_RECORDS_START_INDEX,
+          DatabaseQueries::CREATE_TIMER_RECORDS_GOAL_START_INDEX}},
+        {2, "index todos by date range",
+         {DatabaseQueries::CREATE_TODOS_DATE_RANGE_INDEX}},
+        {3, "store timer records as epoch seconds with a duration column; "
+            "records with unreadable times move to timer_records_unparsed",
+         {DatabaseQueries::CREATE_TIMER_RECORDS_EPOCH_TABLE,
+          DatabaseQueries::SAVE_UNPARSED_TIMER_RECORDS,
+          DatabaseQueries::COPY_TIMER_RECORDS_TO_EPOCH_TABLE,
+          DatabaseQueries::DROP_TIMER_RECORDS_TABLE,
+          DatabaseQueries::RENAME_TIMER_RECORDS_EPOCH_TABLE,
+          DatabaseQueries::CREATE_TIMER_RECORDS_START_COVERING_INDEX,
+          DatabaseQueries::CREATE_TIMER_RECORDS_GOAL_COVERING_INDEX,
+          DatabaseQueries::CREATE_TIMER_RECORDS_DURATION_INDEX},
+         DatabaseQueries::COUNT_UNPARSED_TIMER_RECORDS},
+        {4, "replace dangling goal references with NULL",
+         {DatabaseQueries::CLEAR_DANGLING_TODO_GOALS,
+          DatabaseQueries::CLEAR_DANGLING_TIMER_RECORD_GOALS}},
+        {5, "roll timer records up into daily goal totals",
+         {DatabaseQueries::CREATE_DAILY_GOAL_TOTALS_TABLE,
+          DatabaseQueries::FILL_DAILY_GOAL_TOTALS,
+          DatabaseQueries::CREATE_DAILY_GOAL_TOTALS_INSERT_TRIGGER,
+          DatabaseQueries::CREATE_DAILY_GOAL_TOTALS_DELETE_TRIGGER,
+          DatabaseQueries::CREATE_DAILY_GOAL_TOTALS_UPDATE_TRIGGER}},
+        {6, "index todos by goal",
+         {DatabaseQueries::CREATE_TODOS_GOAL_INDEX}},
+    };
+    return list;
+}
+
+bool DatabaseSchemaManager::applyMigration(QSqlDatabase& db, const Migration& migration)
+{
+    if (!db.transaction()) {
+        qDebug() << "Failed to start migration" << migration.version << ":" << db.lastError().text();
+        return false;
+    }
+
+    // Counted before the statements run, while the rows are still where the query looks
+    if (!migration.setAsideQuery.isEmpty()) {
+        QSqlQuery count(db);
+        if (count.exec(migration.setAsideQuery) && count.next() && count.value(0).toInt() > 0) {
+            qWarning() << "Migration to version" << migration.version << "could not convert"
+                       << count.value(0).toInt() << "rows -" << migration.description;
+        }
+    }
+
+    for (const QString& statement : migration.statements) {
+        if (!executeQuery(db, statement, QString("migrate to version %1 (%2)")
+                                             .arg(migration.version)
+                                             .arg(migration.description))) {
+            db.rollback();
+            return false;
+        }
+    }
+
+    if (!setSchemaVersion(db, migration.version) || !db.commit()) {
+        db.rollback();
+        return false;
+    }
+
+    qDebug() << "Database migrated to version" << migration.version << "-" << migration.description;
+    return true;
+}
+
+bool DatabaseSchemaManager::setSchemaVersion(QSqlDatabase& db, int version)
+{
+    // PRAGMA statements cannot take bound parameters
+    return executeQuery(db, QString("PRAGMA user_version = %1").arg(version), "update schema version");
+}
+
+const QList<DatabaseSchemaManager::HotQuery>& DatabaseSchemaManager::hotQueries()
+{
+    // Column lists only decide whether rows are fetched, never whether they are scanned
+    static const QList<HotQuery> list = {
+        {"timer records by date range", DatabaseConstants::TABLE_TIMER_RECORDS,
+         DatabaseQueries::SELECT_TIMER_RECORDS_IN_RANGE.arg("*")},
+        {"timer records after id", DatabaseConstants::TABLE_TIMER_RECORDS,
+         DatabaseQueries::SELECT_TIMER_RECORDS_AFTER_ID.arg("*")},
+        {"goal time spent", DatabaseConstants::TABLE_TIMER_RECORDS,
+         DatabaseQueries::SUM_GOAL_TIME},
+        {"goal time spent in period", DatabaseConstants::TABLE_TIMER_RECORDS,
+         DatabaseQueries::SUM_GOAL_TIME_IN_PERIOD},
+        {"time per goal in period", DatabaseConstants::TABLE_TIMER_RECORDS,
+         DatabaseQueries::SUM_TIME_PER_GOAL_IN_PERIOD},
+        {"daily goal totals by date range", DatabaseConstants::TABLE_DAILY_GOAL_TOTALS,
+         DatabaseQueries::SELECT_DAILY_GOAL_TOTALS_IN_RANGE},
+        {"todos by date range", DatabaseConstants::TABLE_TODOS,
+         DatabaseQueries::SELECT_TODOS_IN_RANGE.arg("*")},
+        {"pending todos by date range", DatabaseConstants::TABLE_TODOS,
+         DatabaseQueries::SELECT_TODOS_IN_RANGE.arg("*") + DatabaseQueries::PENDING_TODOS_CONDITION},
+        {"todos overlapping a window", DatabaseConstants::TABLE_TODOS,
+         DatabaseQueries::SELECT_TODOS_MATCHING.arg("*") + DatabaseQueries::TODOS_OVERLAP_CONDITION},
+        {"todos of a goal", DatabaseConstants::TABLE_TODOS,
+         DatabaseQueries::SELECT_TODOS_MATCHING.arg("*") + DatabaseQueries::TODOS_GOAL_CONDITION},
+        {"dashboard todo counts", DatabaseConstants::TABLE_TODOS,
+         DatabaseQueries::COUNT_TODOS_BY_WINDOW, true},
+    };
+    return list;
+}
+
+bool DatabaseSchemaManager::verifyQueryPlans(QSqlDatabase& db)
+{
+    // "SCAN timer_records" (or "SCAN TABLE timer_records" before SQLite 3.36)
+    // means the whole table or index is walked instead of searched
+    static const QRegularExpression fullScan("^SCAN (TABLE )?(\\w+)");
+    // Rows sorted into groups after they are read, instead of arriving grouped from an index
+    static const QRegularExpression tempSort("^USE TEMP B-TREE");
+
+    bool allIndexed = true;
+
+    for (const HotQuery& hotQuery : hotQueries()) {
+        const QStringList plan = explainQueryPlan(db, hotQuery.sql);
+        if (plan.isEmpty()) {
+            qCritical() << "Query plan check failed for" << hotQuery.name << ": could not explain query";
+            allIndexed = false;
+            continue;
+        }
+
+        for (const QString& step : plan) {
+            if (hotQuery.readsWholeTable) {
+                if (tempSort.match(step).hasMatch()) {
+                    qCritical() << "Query plan check failed for" << hotQuery.name
+                                << ": rows of" << hotQuery.table << "sorted to group them"
+                                << "- query:" << hotQuery.sql << "- plan:" << plan.join(" | ");
+                    allIndexed = false;
+                    break;
+                }
+                continue;
+            }
+
+            const QRegularExpressionMatch match = fullScan.match(step);
+            if (match.hasMatch() && match.captured(2) == hotQuery.table) {
+                qCritical() << "Query plan check failed for" << hotQuery.name
+                            << ": full scan of" << hotQuery.table
+                            << "- query:" << hotQuery.sql << "- plan:" << plan.join(" | ");
+                allIndexed = false;
+                break;
+            }
+        }
+    }
+
+    return allIndexed;
+}
+
+QStringList DatabaseSchemaManager::explainQueryPlan(QSqlDatabase& db, const QString& query)
+{
+    QStringList plan;
+    QSqlQuery explain(db);
+
+    if (!explain.prepare("EXPLAIN QUERY PLAN " + query)) {
+        qDebug() << "Failed to prepare query plan:" << explain.lastError().text();
+        return plan;
+    }
+
+    // Parameter values do not influence the plan, but every placeholder needs one
+    const int placeholderCount = query.count('?');
+    for (int i = 0; i < placeholderCount; ++i) {
+        explain.addBindValue(0);
+    }
+
+    if (!explain.exec()) {
+        qDebug() << "Failed to explain query:" << explain.lastError().text();
+        return plan;
+    }
+
+    // The plan text is the last column in every SQLite version
+    while (explain.next()) {
+        plan << explain.value(explain.record().count() - 1).toString();
+    }
+
+    return plan;
+}
+
 bool DatabaseSchemaManager::verifySchema(QSqlDatabase& db)
 {
     QSqlQuery query(db);
@@ -29,7 +273,8 @@ bool DatabaseSchemaManager::verifySchema(QSqlDatabase& db)
     
     return existingTables.contains(DatabaseConstants::TABLE_GOALS) &&
            existingTables.contains(DatabaseConstants::TABLE_TODOS) &&
-           existingTables.contains(DatabaseConstants::TABLE_TIMER_RECORDS);
+           existingTables.contains(DatabaseConstants::TABLE_TIMER_RECORDS) &&
+           existingTables.contains(DatabaseConstants::TABLE_DAILY_GOAL_TOTALS);
 }
 
 bool DatabaseSchemaManager::createGoalsTable(QSqlDatabase& db)
@@ -0,0 +1,64 @@
+#include "database/preparedstatementcache.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QDebug>
+
+namespace {
+    // Caches by connection name; the main connection and the executor's live on different threads
+    QMutex registryMutex;
+    QHash<QString, std::shared_ptr<PreparedStatementCache>> registry;
+}
+
+std::shared_ptr<PreparedStatementCache> PreparedStatementCache::forDatabase(const QSqlDatabase& db)
+{
+    QMutexLocker locker(&registryMutex);
+
+    std::shared_ptr<PreparedStatementCache>& cache = registry[db.connectionName()];
+    if (!cache) {
+        cache = std::make_shared<PreparedStatementCache>(db);
+    }
+    return cache;
+}
+
+void PreparedStatementCache::release(const QSqlDatabase& db)
+{
+    std::shared_ptr<PreparedStatementCache> cache;
+    {
+        QMutexLocker locker(&registryMutex);
+        cache = registry.take(db.connectionName());
+    }
+
+    // Repositories may still hold the cache; it simply prepares again if used
+    if (cache) {
+        cache->clear();
+    }
+}
+
+PreparedStatementCache::PreparedStatementCache(const QSqlDatabase& db)
+    : m_database(db)
+{
+}
+
+PreparedStatement PreparedStatementCache::prepare(const QString& sql)
+{
+    auto it = m_statements.constFind(sql);
+    if (it != m_statements.constEnd()) {
+        return PreparedStatement(*it);
+    }
+
+    QSqlQuery query(m_database);
+    if (!query.prepare(sql)) {
+        // Not cached; exec() on the returned query reports the same error
+        qDebug() << "Failed to prepare statement:" << query.lastError().text();
+        return PreparedStatement(query);
+    }
+
+    m_statements.insert(sql, query);
+    return PreparedStatement(query);
+}
+
+void PreparedStatementCache::clear()
+{
+    m_statements.clear();
+}
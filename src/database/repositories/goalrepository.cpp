@@ -1,45 +1,37 @@
 #include "database/repositories/goalrepository.h"
 #include "database/databaseconstants.h"
+#include "database/rowtraits.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
 
 GoalRepository::GoalRepository(QSqlDatabase& db)
     : m_database(db)
+    , m_statements(PreparedStatementCache::forDatabase(db))
 {
 }
 
-bool GoalRepository::add(const DatabaseManager::GoalItem& goal)
+std::optional<int> GoalRepository::add(const DatabaseManager::GoalItem& goal)
 {
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO goals (title, description, is_completed, priority, color_code, estimated_time) "
-                 "VALUES (?, ?, ?, ?, ?, ?)");
+    PreparedStatement query = m_statements->prepare(RowMapping::insertStatement<DatabaseManager::GoalItem>());
+    RowMapping::bind(*query, goal);
     
-    if (!bindGoalToQuery(query, goal)) {
-        return false;
-    }
-    
-    if (!query.exec()) {
-        qDebug() << "Failed to add goal:" << query.lastError().text();
-        return false;
+    if (!query->exec()) {
+        qDebug() << "Failed to add goal:" << query->lastError().text();
+        return std::nullopt;
     }
     
-    return true;
+    return query->lastInsertId().toInt();
 }
 
 bool GoalRepository::update(const DatabaseManager::GoalItem& goal)
 {
-    QSqlQuery query(m_database);
-    query.prepare("UPDATE goals SET title = ?, description = ?, is_completed = ?, "
-                 "priority = ?, color_code = ?, estimated_time = ? WHERE id = ?");
+    PreparedStatement query = m_statements->prepare(RowMapping::updateStatement<DatabaseManager::GoalItem>());
+    RowMapping::bind(*query, goal);
+    query->addBindValue(goal.id);
     
-    if (!bindGoalToQuery(query, goal)) {
-        return false;
-    }
-    query.addBindValue(goal.id);
-    
-    if (!query.exec()) {
-        qDebug() << "Failed to update goal:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "Failed to update goal:" << query->lastError().text();
         return false;
     }
     
@@ -48,12 +40,11 @@ bool GoalRepository::update(const DatabaseManager::GoalItem& goal)
 
 bool GoalRepository::remove(int id)
 {
-    QSqlQuery query(m_database);
-    query.prepare("DELETE FROM goals WHERE id = ?");
-    query.addBindValue(id);
+    PreparedStatement query = m_statements->prepare("DELETE FROM goals WHERE id = ?");
+    query->addBindValue(id);
     
-    if (!query.exec()) {
-        qDebug() << "Failed to delete goal:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "Failed to delete goal:" << query->lastError().text();
         return false;
     }
     
@@ -62,17 +53,16 @@ bool GoalRepository::remove(int id)
 
 std::optional<DatabaseManager::GoalItem> GoalRepository::findById(int id) const
 {
-    QSqlQuery query(m_database);
-    query.prepare(DatabaseQueries::SELECT_GOAL_BY_ID);
-    query.addBindValue(id);
+    PreparedStatement query = m_statements->prepare(RowMapping::select<DatabaseManager::GoalItem>(DatabaseQueries::SELECT_GOAL_BY_ID));
+    query->addBindValue(id);
     
-    if (!query.exec()) {
-        qDebug() << "Failed to find goal by id:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "Failed to find goal by id:" << query->lastError().text();
         return std::nullopt;
     }
     
-    if (query.next()) {
-        return mapFromQuery(query);
+    if (query->next()) {
+        return RowMapping::map<DatabaseManager::GoalItem>(*query);
     }
     
     return std::nullopt;
@@ -81,20 +71,16 @@ std::optional<DatabaseManager::GoalItem> GoalRepository::findById(int id) const
 QList<DatabaseManager::GoalItem> GoalRepository::findAll(bool includeCompleted) const
 {
     QList<DatabaseManager::GoalItem> goals;
-    QSqlQuery query(m_database);
-    
-    QString queryStr = DatabaseQueries::SELECT_ALL_GOALS;
-    if (!includeCompleted) {
-        queryStr = "SELECT * FROM goals WHERE is_completed = 0 ORDER BY priority DESC, id ASC";
-    }
     
-    if (!query.exec(queryStr)) {
-        qDebug() << "Failed to get all goals:" << query.lastError().text();
+    const QString& sql = includeCompleted ? DatabaseQueries::SELECT_ALL_GOALS : DatabaseQueries::SELECT_PENDING_GOALS;
+    PreparedStatement query = m_statements->prepare(RowMapping::select<DatabaseManager::GoalItem>(sql));
+    if (!query->exec()) {
+        qDebug() << "Failed to get all goals:" << query->lastError().text();
         return goals;
     }
     
-    while (query.next()) {
-        goals.append(mapFromQuery(query));
+    while (query->next()) {
+        goals.append(RowMapping::map<DatabaseManager::GoalItem>(*query));
     }
     
     return goals;
@@ -102,13 +88,12 @@ QList<DatabaseManager::GoalItem> GoalRepository::findAll(bool includeCompleted)
 
 bool GoalRepository::toggleCompletion(int id, bool completed)
 {
-    QSqlQuery query(m_database);
-    query.prepare("UPDATE goals SET is_completed = ? WHERE id = ?");
-    query.addBindValue(completed);
-    query.addBindValue(id);
+    PreparedStatement query = m_statements->prepare("UPDATE goals SET is_completed = ? WHERE id = ?");
+    query->addBindValue(completed);
+    query->addBindValue(id);
     
-    if (!query.exec()) {
-        qDebug() << "Failed to toggle goal completion:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "Failed to toggle goal completion:" << query->lastError().text();
         return false;
     }
     
@@ -122,13 +107,11 @@ bool GoalRepository::markAsCompleted(int id)
 
 int GoalRepository::getTimeSpent(int goalId) const
 {
-    QSqlQuery query(m_database);
-    query.prepare("SELECT SUM(strftime('%s', end_time) - strftime('%s', start_time)) "
-                 "FROM timer_records WHERE goal_id = ?");
-    query.addBindValue(goalId);
+    PreparedStatement query = m_statements->prepare(DatabaseQueries::SUM_GOAL_TIME);
+    query->addBindValue(goalId);
     
-    if (query.exec() && query.next()) {
-        return query.value(0).toInt();
+    if (query->exec() && query->next()) {
+        return query->value(0).toInt();
     }
     
     return 0;
@@ -136,44 +119,70 @@ int GoalRepository::getTimeSpent(int goalId) const
 
 int GoalRepository::getTimeSpentInPeriod(int goalId, const QDate& startDate, const QDate& endDate) const
 {
-    QSqlQuery query(m_database);
-    query.prepare("SELECT SUM(CAST((julianday(end_time) - julianday(start_time)) * 86400 AS INTEGER)) "
-                 "FROM timer_records "
-                 "WHERE goal_id = ? AND DATE(start_time) >= ? AND DATE(start_time) <= ?");
+    PreparedStatement query = m_statements->prepare(DatabaseQueries::SUM_GOAL_TIME_IN_PERIOD);
+    
+    // Time within [startDate, endDate + 1) local time, answered from the
+    // (goal_id, start_time, duration_seconds) index alone
+    const qint64 periodStart = startDate.startOfDay().toSecsSinceEpoch();
+    const qint64 periodEnd = endDate.addDays(1).startOfDay().toSecsSinceEpoch();
+    query->addBindValue(periodEnd);
+    query->addBindValue(periodStart);
+    query->addBindValue(goalId);
+    query->addBindValue(periodEnd);
+    query->addBindValue(periodStart);
+    query->addBindValue(periodStart);
+    
+    if (query->exec() && query->next()) {
+        return query->value(0).toInt();
+    }
     
-    query.addBindValue(goalId);
-    query.addBindValue(startDate.toString(DatabaseConstants::DATE_FORMAT));
-    query.addBindValue(endDate.toString(DatabaseConstants::DATE_FORMAT));
+    return 0;
+}
+
+QMap<int, DatabaseManager::GoalTime> GoalRepository::getTimePerGoal() const
+{
+    PreparedStatement query = m_statements->prepare(DatabaseQueries::SUM_TIME_PER_GOAL);
     
-    if (query.exec() && query.next()) {
-        return query.value(0).toInt();
+    if (!query->exec()) {
+        qDebug() << "Failed to get time per goal:" << query->lastError().text();
+        return QMap<int, DatabaseManager::GoalTime>();
     }
     
-    return 0;
+    return collectTimePerGoal(*query);
 }
 
-DatabaseManager::GoalItem GoalRepository::mapFromQuery(const QSqlQuery& query) const
+QMap<int, DatabaseManager::GoalTime> GoalRepository::getTimePerGoalInPeriod(const QDate& startDate, const QDate& endDate) const
 {
-    DatabaseManager::GoalItem goal;
-    goal.id = query.value("id").toInt();
-    goal.title = query.value("title").toString();
-    goal.description = query.value("description").toString();
-    goal.isCompleted = query.value("is_completed").toBool();
-    goal.priority = static_cast<DatabaseManager::TodoPriority>(query.value("priority").toInt());
-    goal.colorCode = query.value("color_code").toString();
-    goal.estimatedTime = query.value("estimated_time").toInt();
-    
-    return goal;
+    PreparedStatement query = m_statements->prepare(DatabaseQueries::SUM_TIME_PER_GOAL_IN_PERIOD);
+    const qint64 periodStart = startDate.startOfDay().toSecsSinceEpoch();
+    const qint64 periodEnd = endDate.addDays(1).startOfDay().toSecsSinceEpoch();
+    query->addBindValue(periodEnd);
+    query->addBindValue(periodStart);
+    query->addBindValue(periodStart);
+    query->addBindValue(periodEnd);
+    query->addBindValue(periodStart);
+    query->addBindValue(periodStart);
+    
+    if (!query->exec()) {
+        qDebug() << "Failed to get time per goal in period:" << query->lastError().text();
+        return QMap<int, DatabaseManager::GoalTime>();
+    }
+    
+    return collectTimePerGoal(*query);
 }
 
-bool GoalRepository::bindGoalToQuery(QSqlQuery& query, const DatabaseManager::GoalItem& goal) const
+QMap<int, DatabaseManager::GoalTime> GoalRepository::collectTimePerGoal(QSqlQuery& query) const
 {
-    query.addBindValue(goal.title);
-    query.addBindValue(goal.description);
-    query.addBindValue(goal.isCompleted);
-    query.addBindValue(static_cast<int>(goal.priority));
-    query.addBindValue(goal.colorCode);
-    query.addBindValue(goal.estimatedTime);
+    QMap<int, DatabaseManager::GoalTime> timePerGoal;
     
-    return true;
-}
\ No newline at end of file
+    while (query.next()) {
+        const int goalId = query.value(0).isNull() ? DatabaseManager::NO_GOAL_ID : query.value(0).toInt();
+        
+        // NULL and NO_GOAL_ID arrive as separate groups
+        DatabaseManager::GoalTime& time = timePerGoal[goalId];
+        time.seconds += query.value(1).toInt();
+        time.sessions += query.value(2).toInt();
+    }
+    
+    return timePerGoal;
+}
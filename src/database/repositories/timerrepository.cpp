@@ -1,43 +1,41 @@
 #include "database/repositories/timerrepository.h"
 #include "database/databaseconstants.h"
+#include "database/rowtraits.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
 
 TimerRepository::TimerRepository(QSqlDatabase& db)
     : m_database(db)
+    , m_statements(PreparedStatementCache::forDatabase(db))
 {
 }
 
-bool TimerRepository::add(const DatabaseManager::TimerRecord& record)
+std::optional<int> TimerRepository::add(const DatabaseManager::TimerRecord& record)
 {
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO timer_records (goal_id, start_time, end_time) VALUES (?, ?, ?)");
-    query.addBindValue(record.goalId);
-    query.addBindValue(record.startTime);
-    query.addBindValue(record.endTime);
-    
-    if (!query.exec()) {
-        qDebug() << "Failed to add timer record:" << query.lastError().text();
-        return false;
+    PreparedStatement query = m_statements->prepare(RowMapping::insertStatement<DatabaseManager::TimerRecord>());
+    RowMapping::bind(*query, record);
+    
+    if (!query->exec()) {
+        qDebug() << "Failed to add timer record:" << query->lastError().text();
+        return std::nullopt;
     }
     
-    return true;
+    return query->lastInsertId().toInt();
 }
 
 std::optional<DatabaseManager::TimerRecord> TimerRepository::findById(int id) const
 {
-    QSqlQuery query(m_database);
-    query.prepare("SELECT * FROM timer_records WHERE id = ?");
-    query.addBindValue(id);
+    PreparedStatement query = m_statements->prepare(RowMapping::select<DatabaseManager::TimerRecord>(DatabaseQueries::SELECT_TIMER_RECORD_BY_ID));
+    query->addBindValue(id);
     
-    if (!query.exec()) {
-        qDebug() << "Failed to find timer record by id:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "Failed to find timer record by id:" << query->lastError().text();
         return std::nullopt;
     }
     
-    if (query.next()) {
-        return mapFromQuery(query);
+    if (query->next()) {
+        return RowMapping::map<DatabaseManager::TimerRecord>(*query);
     }
     
     return std::nullopt;
@@ -46,53 +44,108 @@ std::optional<DatabaseManager::TimerRecord> TimerRepository::findById(int id) co
 QList<DatabaseManager::TimerRecord> TimerRepository::findByDateRange(const QDateTime& start, const QDateTime& end) const
 {
     QList<DatabaseManager::TimerRecord> records;
-    QSqlQuery query(m_database);
-    
-    query.prepare(
-        "SELECT * FROM timer_records WHERE "
-        "(start_time BETWEEN ? AND ?) OR "
-        "(end_time BETWEEN ? AND ?) OR "
-        "(start_time <= ? AND end_time >= ?) "
-        "ORDER BY start_time DESC"
-    );
-    
-    query.addBindValue(start);
-    query.addBindValue(end);
-    query.addBindValue(start);
-    query.addBindValue(end);
-    query.addBindValue(start);
-    query.addBindValue(end);
-    
-    if (!query.exec()) {
-        qDebug() << "Failed to get timer records by date range:" << query.lastError().text();
+    
+    // Overlap test: the record starts before the range ends and ends after it starts
+    PreparedStatement query = m_statements->prepare(RowMapping::select<DatabaseManager::TimerRecord>(DatabaseQueries::SELECT_TIMER_RECORDS_IN_RANGE));
+    query->addBindValue(end.toSecsSinceEpoch());
+    query->addBindValue(start.toSecsSinceEpoch());
+    query->addBindValue(start.toSecsSinceEpoch());
+    
+    if (!query->exec()) {
+        qDebug() << "Failed to get timer records by date range:" << query->lastError().text();
+        return records;
+    }
+    
+    while (query->next()) {
+        records.append(RowMapping::map<DatabaseManager::TimerRecord>(*query));
+    }
+    
+    return records;
+}
+
+QList<DatabaseManager::TimerRecord> TimerRepository::findAfterId(int id) const
+{
+    QList<DatabaseManager::TimerRecord> records;
+    
+    PreparedStatement query = m_statements->prepare(RowMapping::select<DatabaseManager::TimerRecord>(DatabaseQueries::SELECT_TIMER_RECORDS_AFTER_ID));
+    query->addBindValue(id);
+    
+    if (!query->exec()) {
+        qDebug() << "Failed to get timer records after id:" << query->lastError().text();
         return records;
     }
     
-    while (query.next()) {
-        records.append(mapFromQuery(query));
+    while (query->next()) {
+        records.append(RowMapping::map<DatabaseManager::TimerRecord>(*query));
     }
     
     return records;
 }
 
+QList<DatabaseManager::DailyGoalTotal> TimerRepository::findDailyTotals(const QDate& startDate, const QDate& endDate) const
+{
+    QList<DatabaseManager::DailyGoalTotal> totals;
+    
+    PreparedStatement query = m_statements->prepare(DatabaseQueries::SELECT_DAILY_GOAL_TOTALS_IN_RANGE);
+    query->addBindValue(startDate.toString(DatabaseConstants::DATE_FORMAT));
+    query->addBindValue(endDate.toString(DatabaseConstants::DATE_FORMAT));
+    
+    if (!query->exec()) {
+        qDebug() << "Failed to get daily goal totals:" << query->lastError().text();
+        return totals;
+    }
+    
+    while (query->next()) {
+        DatabaseManager::DailyGoalTotal total;
+        total.day = QDate::fromString(query->value(0).toString(), DatabaseConstants::DATE_FORMAT);
+        total.goalId = query->value(1).toInt();
+        total.seconds = query->value(2).toInt();
+        total.sessions = query->value(3).toInt();
+        totals.append(total);
+    }
+    
+    return totals;
+}
+
+QMap<int, DatabaseManager::GoalTimeWindows> TimerRepository::sumDailyTotalsByWindow(const QDate& today,
+                                                                                     const QDate& weekStart,
+                                                                                     const QDate& weekEnd) const
+{
+    QMap<int, DatabaseManager::GoalTimeWindows> windows;
+    
+    PreparedStatement query = m_statements->prepare(DatabaseQueries::SUM_DAILY_GOAL_TOTALS_BY_WINDOW);
+    const QString day = today.toString(DatabaseConstants::DATE_FORMAT);
+    const QString first = weekStart.toString(DatabaseConstants::DATE_FORMAT);
+    const QString last = weekEnd.toString(DatabaseConstants::DATE_FORMAT);
+    for (const QString& value : {day, day, first, last, first, last}) {
+        query->addBindValue(value);
+    }
+    
+    if (!query->exec()) {
+        qDebug() << "Failed to sum daily goal totals:" << query->lastError().text();
+        return windows;
+    }
+    
+    while (query->next()) {
+        DatabaseManager::GoalTimeWindows& goal = windows[query->value(0).toInt()];
+        goal.today.seconds = query->value(1).toInt();
+        goal.today.sessions = query->value(2).toInt();
+        goal.week.seconds = query->value(3).toInt();
+        goal.week.sessions = query->value(4).toInt();
+        goal.total.seconds = query->value(5).toInt();
+        goal.total.sessions = query->value(6).toInt();
+    }
+    
+    return windows;
+}
+
 bool TimerRepository::clear()
 {
-    QSqlQuery query(m_database);
-    if (!query.exec("DELETE FROM timer_records")) {
-        qDebug() << "Failed to clear timer records:" << query.lastError().text();
+    PreparedStatement query = m_statements->prepare("DELETE FROM timer_records");
+    if (!query->exec()) {
+        qDebug() << "Failed to clear timer records:" << query->lastError().text();
         return false;
     }
     
     return true;
 }
-
-DatabaseManager::TimerRecord TimerRepository::mapFromQuery(const QSqlQuery& query) const
-{
-    DatabaseManager::TimerRecord record;
-    record.id = query.value("id").toInt();
-    record.goalId = query.value("goal_id").toInt();
-    record.startTime = query.value("start_time").toDateTime();
-    record.endTime = query.value("end_time").toDateTime();
-    
-    return record;
-}
\ No newline at end of file
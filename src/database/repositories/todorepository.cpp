@@ -1,42 +1,38 @@
 #include "database/repositories/todorepository.h"
 #include "database/databaseconstants.h"
+#include "database/rowtraits.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
+#include <algorithm>
 
 TodoRepository::TodoRepository(QSqlDatabase& db)
     : m_database(db)
+    , m_statements(PreparedStatementCache::forDatabase(db))
 {
 }
 
-bool TodoRepository::add(const DatabaseManager::TodoItem& todo)
+std::optional<int> TodoRepository::add(const DatabaseManager::TodoItem& todo)
 {
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO todos (goal_id, title, description, is_completed, priority, color_code, "
-                  "start_date, end_date) VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+    PreparedStatement query = m_statements->prepare(RowMapping::insertStatement<DatabaseManager::TodoItem>());
+    RowMapping::bind(*query, todo);
     
-    if (!bindTodoToQuery(query, todo)) {
-        return false;
-    }
-    
-    if (!query.exec()) {
-        qDebug() << "Failed to add todo:" << query.lastError().text();
-        return false;
+    if (!query->exec()) {
+        qDebug() << "Failed to add todo:" << query->lastError().text();
+        return std::nullopt;
     }
     
-    return true;
+    return query->lastInsertId().toInt();
 }
 
 bool TodoRepository::update(const DatabaseManager::TodoItem& todo)
 {
-    QSqlQuery query(m_database);
-    query.prepare("UPDATE todos SET goal_id = ?, title = ?, description = ?, "
-                 "is_completed = ?, priority = ?, color_code = ?, start_date = ?, end_date = ? WHERE id = ?");
-
-    query.addBindValue(todo.id);
+    PreparedStatement query = m_statements->prepare(RowMapping::updateStatement<DatabaseManager::TodoItem>());
+    RowMapping::bind(*query, todo);
+    query->addBindValue(todo.id);
     
-    if (!query.exec()) {
-        qDebug() << "Failed to update todo:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "Failed to update todo:" << query->lastError().text();
         return false;
     }
     
@@ -45,12 +41,11 @@ bool TodoRepository::update(const DatabaseManager::TodoItem& todo)
 
 bool TodoRepository::remove(int id)
 {
-    QSqlQuery query(m_database);
-    query.prepare("DELETE FROM todos WHERE id = ?");
-    query.addBindValue(id);
+    PreparedStatement query = m_statements->prepare("DELETE FROM todos WHERE id = ?");
+    query->addBindValue(id);
     
-    if (!query.exec()) {
-        qDebug() << "Failed to delete todo:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "Failed to delete todo:" << query->lastError().text();
         return false;
     }
     
@@ -59,17 +54,16 @@ bool TodoRepository::remove(int id)
 
 std::optional<DatabaseManager::TodoItem> TodoRepository::findById(int id) const
 {
-    QSqlQuery query(m_database);
-    query.prepare(DatabaseQueries::SELECT_TODO_BY_ID);
-    query.addBindValue(id);
+    PreparedStatement query = m_statements->prepare(RowMapping::select<DatabaseManager::TodoItem>(DatabaseQueries::SELECT_TODO_BY_ID));
+    query->addBindValue(id);
     
-    if (!query.exec()) {
-        qDebug() << "Failed to find todo by id:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "Failed to find todo by id:" << query->lastError().text();
         return std::nullopt;
     }
     
-    if (query.next()) {
-        return mapFromQuery(query);
+    if (query->next()) {
+        return RowMapping::map<DatabaseManager::TodoItem>(*query);
     }
     
     return std::nullopt;
@@ -78,20 +72,16 @@ std::optional<DatabaseManager::TodoItem> TodoRepository::findById(int id) const
 QList<DatabaseManager::TodoItem> TodoRepository::findAll(bool includeCompleted) const
 {
     QList<DatabaseManager::TodoItem> todos;
-    QSqlQuery query(m_database);
-    
-    QString queryStr = DatabaseQueries::SELECT_ALL_TODOS;
-    if (!includeCompleted) {
-        queryStr = "SELECT * FROM todos WHERE is_completed = 0 ORDER BY priority DESC, id ASC";
-    }
     
-    if (!query.exec(queryStr)) {
-        qDebug() << "Failed to get all todos:" << query.lastError().text();
+    const QString& sql = includeCompleted ? DatabaseQueries::SELECT_ALL_TODOS : DatabaseQueries::SELECT_PENDING_TODOS;
+    PreparedStatement query = m_statements->prepare(RowMapping::select<DatabaseManager::TodoItem>(sql));
+    if (!query->exec()) {
+        qDebug() << "Failed to get all todos:" << query->lastError().text();
         return todos;
     }
     
-    while (query.next()) {
-        todos.append(mapFromQuery(query));
+    while (query->next()) {
+        todos.append(RowMapping::map<DatabaseManager::TodoItem>(*query));
     }
     
     return todos;
@@ -100,89 +90,142 @@ QList<DatabaseManager::TodoItem> TodoRepository::findAll(bool includeCompleted)
 QList<DatabaseManager::TodoItem> TodoRepository::findByDateRange(const QDate& startDate, const QDate& endDate, bool includeCompleted) const
 {
     QList<DatabaseManager::TodoItem> todos;
-    QSqlQuery query(m_database);
     
-    QString sql = "SELECT id, title, description, priority, is_completed, goal_id, color_code, start_date, end_date, last_update "
-                  "FROM todos WHERE ((start_date BETWEEN ? AND ?) OR (end_date BETWEEN ? AND ?) OR "
-                  "(start_date <= ? AND end_date >= ?))";
+    // Same matches as "starts, ends or spans the range", written so that every
+    // branch can be answered from the (start_date, end_date, is_completed) index
+    QString sql = RowMapping::select<DatabaseManager::TodoItem>(DatabaseQueries::SELECT_TODOS_IN_RANGE);
     if (!includeCompleted) {
-        sql += " AND is_completed = 0";
+        sql += DatabaseQueries::PENDING_TODOS_CONDITION;
     }
-    sql += " ORDER BY start_date ASC";
     
-    query.prepare(sql);
-    query.addBindValue(startDate);
-    query.addBindValue(endDate);
-    query.addBindValue(startDate);
-    query.addBindValue(endDate);
-    query.addBindValue(startDate);
-    query.addBindValue(endDate);
+    PreparedStatement query = m_statements->prepare(sql);
+    query->addBindValue(endDate);
+    query->addBindValue(startDate);
+    query->addBindValue(startDate);
+    query->addBindValue(endDate);
+    query->addBindValue(startDate);
+    query->addBindValue(endDate);
     
-    if (!query.exec()) {
-        qDebug() << "Failed to get todos by date range:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "Failed to get todos by date range:" << query->lastError().text();
         return todos;
     }
     
-    while (query.next()) {
-        todos.append(mapFromQuery(query));
+    while (query->next()) {
+        todos.append(RowMapping::map<DatabaseManager::TodoItem>(*query));
     }
     
+    // Sorted here rather than with ORDER BY, which would turn the index lookup into a scan
+    std::stable_sort(todos.begin(), todos.end(),
+                     [](const DatabaseManager::TodoItem& a, const DatabaseManager::TodoItem& b) {
+                         return a.startDate < b.startDate;
+                     });
+    
     return todos;
 }
 
-bool TodoRepository::toggleCompletion(int id, bool completed)
+QList<DatabaseManager::TodoItem> TodoRepository::findMatching(const DatabaseManager::TodoFilter& filter) const
 {
-    QSqlQuery query(m_database);
-    query.prepare("UPDATE todos SET is_completed = ? WHERE id = ?");
-    query.addBindValue(completed);
-    query.addBindValue(id);
+    QList<DatabaseManager::TodoItem> todos;
     
-    if (!query.exec()) {
-        qDebug() << "Failed to toggle todo completion:" << query.lastError().text();
-        return false;
+    const QString sql = RowMapping::select<DatabaseManager::TodoItem>(DatabaseQueries::SELECT_TODOS_MATCHING) +
+                        filterConditions(filter) + DatabaseQueries::TODOS_ORDER;
+    PreparedStatement query = m_statements->prepare(sql);
+    bindFilter(*query, filter);
+    
+    if (!query->exec()) {
+        qDebug() << "Failed to get matching todos:" << query->lastError().text();
+        return todos;
     }
     
-    return true;
+    while (query->next()) {
+        todos.append(RowMapping::map<DatabaseManager::TodoItem>(*query));
+    }
+    
+    return todos;
 }
 
-bool TodoRepository::clear()
+QMap<int, DatabaseManager::TodoCountWindows> TodoRepository::countByWindow(const QDate& today,
+                                                                           const QDate& weekStart,
+                                                                           const QDate& weekEnd) const
 {
-    QSqlQuery query(m_database);
-    if (!query.exec("DELETE FROM todos")) {
-        qDebug() << "Failed to clear todos:" << query.lastError().text();
-        return false;
+    QMap<int, DatabaseManager::TodoCountWindows> windows;
+    
+    PreparedStatement query = m_statements->prepare(DatabaseQueries::COUNT_TODOS_BY_WINDOW);
+    query->addBindValue(today);
+    query->addBindValue(today);
+    query->addBindValue(weekEnd);
+    query->addBindValue(weekStart);
+    
+    if (!query->exec()) {
+        qDebug() << "Failed to count todos by window:" << query->lastError().text();
+        return windows;
     }
     
-    return true;
+    while (query->next()) {
+        const int goalId = query->value(0).isNull() ? DatabaseManager::NO_GOAL_ID : query->value(0).toInt();
+        const bool isCompleted = query->value(1).toBool();
+        
+        // NULL and NO_GOAL_ID arrive as separate groups
+        DatabaseManager::TodoCountWindows& goal = windows[goalId];
+        (isCompleted ? goal.today.completed : goal.today.pending) += query->value(2).toInt();
+        (isCompleted ? goal.week.completed : goal.week.pending) += query->value(3).toInt();
+        (isCompleted ? goal.total.completed : goal.total.pending) += query->value(4).toInt();
+    }
+    
+    return windows;
+}
+
+QString TodoRepository::filterConditions(const DatabaseManager::TodoFilter& filter)
+{
+    // Only the conditions that narrow anything, so each filter shape gets its own cached
+    // statement and its own index: the date range one for windows, the goal one for goals
+    QString conditions;
+    if (filter.startDate.isValid() || filter.endDate.isValid()) {
+        conditions += DatabaseQueries::TODOS_OVERLAP_CONDITION;
+    }
+    if (filter.goalId) {
+        conditions += DatabaseQueries::TODOS_GOAL_CONDITION;
+    }
+    if (!filter.includeCompleted) {
+        conditions += DatabaseQueries::PENDING_TODOS_CONDITION;
+    }
+    return conditions;
+}
+
+void TodoRepository::bindFilter(QSqlQuery& query, const DatabaseManager::TodoFilter& filter)
+{
+    if (filter.startDate.isValid() || filter.endDate.isValid()) {
+        // An open side compares against a date no todo reaches
+        query.addBindValue(filter.endDate.isValid() ? filter.endDate : QDate(9999, 12, 31));
+        query.addBindValue(filter.startDate.isValid() ? filter.startDate : QDate(1, 1, 1));
+    }
+    if (filter.goalId) {
+        query.addBindValue(*filter.goalId);
+    }
 }
 
-DatabaseManager::TodoItem TodoRepository::mapFromQuery(const QSqlQuery& query) const
+bool TodoRepository::toggleCompletion(int id, bool completed)
 {
-    DatabaseManager::TodoItem todo;
-    todo.id = query.value("id").toInt();
-    todo.title = query.value("title").toString();
-    todo.description = query.value("description").toString();
-    todo.priority = static_cast<DatabaseManager::TodoPriority>(query.value("priority").toInt());
-    todo.isCompleted = query.value("is_completed").toBool();
-    todo.goalId = query.value("goal_id").toInt();
-    todo.colorCode = query.value("color_code").toString();
-    todo.startDate = query.value("start_date").toDate();
-    todo.endDate = query.value("end_date").toDate();
-    todo.lastUpdate = query.value("last_update").toDateTime();
-    
-    return todo;
+    PreparedStatement query = m_statements->prepare("UPDATE todos SET is_completed = ? WHERE id = ?");
+    query->addBindValue(completed);
+    query->addBindValue(id);
+    
+    if (!query->exec()) {
+        qDebug() << "Failed to toggle todo completion:" << query->lastError().text();
+        return false;
+    }
+    
+    return true;
 }
 
-bool TodoRepository::bindTodoToQuery(QSqlQuery& query, const DatabaseManager::TodoItem& todo) const
+bool TodoRepository::clear()
 {
-    query.addBindValue(todo.goalId);
-    query.addBindValue(todo.title);
-    query.addBindValue(todo.description);
-    query.addBindValue(todo.isCompleted);
-    query.addBindValue(static_cast<int>(todo.priority));
-    query.addBindValue(todo.colorCode);
-    query.addBindValue(todo.startDate);
-    query.addBindValue(todo.endDate);
+    PreparedStatement query = m_statements->prepare("DELETE FROM todos");
+    if (!query->exec()) {
+        qDebug() << "Failed to clear todos:" << query->lastError().text();
+        return false;
+    }
     
     return true;
-}
\ No newline at end of file
+}
@@ -37,18 +37,13 @@ public:
         int goalId = index.data(Qt::UserRole).toInt();
         if (goalId <= 0) return;
 
-        // Find the goal to get its color
+        // Color and state come from the goal cache, so painting never queries the database
+        static const QColor defaultColor("#FF6B7A"); // tomato red default
         DatabaseManager& db = DatabaseManager::instance();
-        auto goals = db.getAllGoals(true); // Get all goals including completed
-        QString color = "#FF6B7A"; // tomato red default
-        bool isCompleted = false;
-
-        for (const auto& goal : goals) {
-            if (goal.id == goalId) {
-                color = goal.colorCode.isEmpty() ? "#FF6B7A" : goal.colorCode;
-                isCompleted = goal.isCompleted;
-                break;
-            }
+        const bool isCompleted = db.getGoal(goalId).isCompleted;
+        QColor color = db.getGoalColor(goalId);
+        if (!color.isValid()) {
+            color = defaultColor;
         }
 
         // Draw colored bullet point
@@ -56,12 +51,9 @@ public:
 
         // For completed goals, make the color more subdued
         if (isCompleted) {
-            QColor completedColor(color);
-            completedColor.setAlpha(150); // Make it semi-transparent
-            painter->setPen(completedColor);
-        } else {
-            painter->setPen(QColor(color));
+            color.setAlpha(150); // Make it semi-transparent
         }
+        painter->setPen(color);
 
         QFont font = painter->font();
         font.setPointSize(12);
@@ -645,6 +637,10 @@ void MainWindow::connectSignals()
         connect(m_settingsDialog, &SettingsDialog::settingsChanged,
                 this, &MainWindow::onSettingsChanged);
     }
+
+    // Pages subscribe to the changes they display; the sidebar follows goal changes
+    connect(&DatabaseManager::instance(), &DatabaseManager::dataChanged,
+            this, &MainWindow::onDataChanged);
 }
 
 void MainWindow::onSidebarItemClicked(int index)
@@ -656,21 +652,6 @@ void MainWindow::onSidebarItemClicked(int index)
         // Clear goal selections when switching to main tabs
         m_goalsList->clearSelection();
         m_completedGoalsList->clearSelection();
-
-        // Refresh the current widget using the correct method name
-        QWidget* currentWidget = m_stackedWidget->currentWidget();
-
-        if (currentWidget == m_calendarWidget) {
-            m_calendarWidget->refreshFromDatabase();
-        } else if (currentWidget == m_statisticsWidget) {
-            m_statisticsWidget->refreshFromDatabase();
-        } else if (currentWidget == m_dailyDashboardWidget) {
-            m_dailyDashboardWidget->refreshFromDatabase();
-        } else if (currentWidget == m_weeklyDashboardWidget) {
-            m_weeklyDashboardWidget->refreshFromDatabase();
-        } else if (currentWidget == m_totalDashboardWidget) {
-            m_totalDashboardWidget->refreshFromDatabase();
-        }
     }
 }
 
@@ -688,7 +669,6 @@ void MainWindow::onGoalListItemClicked(int index)
 
             if (m_goalDashboardWidget) {
                 m_goalDashboardWidget->setCurrentGoal(goalId);
-                m_goalDashboardWidget->refreshFromDatabase();
             }
         }
     }
@@ -708,7 +688,6 @@ void MainWindow::onCompletedGoalListItemClicked(int index)
 
             if (m_goalDashboardWidget) {
                 m_goalDashboardWidget->setCurrentGoal(goalId);
-                m_goalDashboardWidget->refreshFromDatabase();
             }
         }
     }
@@ -759,21 +738,7 @@ void MainWindow::onAddTodoClicked()
     TodoDialog dialog(newTodo, this);
     if (dialog.exec() == QDialog::Accepted) {
         DatabaseManager::TodoItem todoToAdd = dialog.getTodo();
-        if (DatabaseManager::instance().addTodo(todoToAdd)) {
-            refreshGoalsList();
-
-            // Refresh current view
-            QWidget* currentWidget = m_stackedWidget->currentWidget();
-            if (currentWidget == m_dailyDashboardWidget) {
-                m_dailyDashboardWidget->refreshFromDatabase();
-            } else if (currentWidget == m_weeklyDashboardWidget) {
-                m_weeklyDashboardWidget->refreshFromDatabase();
-            } else if (currentWidget == m_totalDashboardWidget) {
-                m_totalDashboardWidget->refreshFromDatabase();
-            } else if (currentWidget == m_goalDashboardWidget) {
-                m_goalDashboardWidget->refreshFromDatabase();
-            }
-        }
+        DatabaseManager::instance().addTodo(todoToAdd);
     }
 }
 
@@ -791,21 +756,7 @@ void MainWindow::onAddGoalClicked()
     GoalDialog dialog(newGoal, this);
     if (dialog.exec() == QDialog::Accepted) {
         DatabaseManager::GoalItem goalToAdd = dialog.getGoal();
-        if (DatabaseManager::instance().addGoal(goalToAdd)) {
-            refreshGoalsList();
-
-            // Refresh current view
-            QWidget* currentWidget = m_stackedWidget->currentWidget();
-            if (currentWidget == m_dailyDashboardWidget) {
-                m_dailyDashboardWidget->refreshFromDatabase();
-            } else if (currentWidget == m_weeklyDashboardWidget) {
-                m_weeklyDashboardWidget->refreshFromDatabase();
-            } else if (currentWidget == m_totalDashboardWidget) {
-                m_totalDashboardWidget->refreshFromDatabase();
-            } else if (currentWidget == m_goalDashboardWidget) {
-                m_goalDashboardWidget->refreshFromDatabase();
-            }
-        }
+        DatabaseManager::instance().addGoal(goalToAdd);
     }
 }
 
@@ -865,27 +816,26 @@ void MainWindow::onEditTodoRequested(int todoId)
     if (dialog.exec() == QDialog::Accepted) {
         DatabaseManager::TodoItem updatedTodo = dialog.getTodo();
 
-        // Update the todo in database
-        if (DatabaseManager::instance().updateTodo(updatedTodo)) {
-            // Refresh all dashboard widgets (correct method name)
-            if (m_dailyDashboardWidget) {
-                m_dailyDashboardWidget->refreshFromDatabase();
-            }
-            if (m_weeklyDashboardWidget) {
-                m_weeklyDashboardWidget->refreshFromDatabase();
-            }
-            if (m_totalDashboardWidget) {
-                m_totalDashboardWidget->refreshFromDatabase();
-            }
-            if (m_goalDashboardWidget) {
-                m_goalDashboardWidget->refreshFromDatabase();
-            }
-        } else {
+        // Update the todo in database; visible pages refresh from the change notification
+        if (!DatabaseManager::instance().updateTodo(updatedTodo)) {
             QMessageBox::warning(this, tr("Error"), tr("Failed to update todo."));
         }
     }
 }
 
+void MainWindow::onDataChanged(const DatabaseManager::ChangeSet& changes)
+{
+    if (changes.affects(DatabaseManager::Entity::Goal)) {
+        refreshGoalsList();
+    }
+
+    // The timer lists goals and shows today's focused time
+    if (m_timerWidget && (changes.affects(DatabaseManager::Entity::Goal) ||
+                          changes.affects(DatabaseManager::Entity::TimerRecord))) {
+        m_timerWidget->refreshGoalsList();
+    }
+}
+
 void MainWindow::updateGoalsList()
 {
     // Update pending goals list
@@ -0,0 +1,221 @@
+#include "statistics/components/focustrends.h"
+#include "statistics/components/intervalsplitter.h"
+#include "statistics/components/statisticsperiod.h"
+#include "database/databaseexecutor.h"
+#include <algorithm>
+
+FocusTrends& FocusTrends::instance()
+{
+    static FocusTrends instance;
+    return instance;
+}
+
+FocusTrends::FocusTrends()
+    : QObject()
+    , m_isLoaded(false)
+    , m_isLoading(false)
+    , m_reloadQueued(false)
+{
+    reset();
+
+    connect(&DatabaseManager::instance(), &DatabaseManager::dataChanged,
+            this, &FocusTrends::onDataChanged);
+}
+
+FocusTrends::Summary FocusTrends::summary()
+{
+    Summary summary;
+    if (!m_isLoaded) {
+        load();
+        return summary;
+    }
+
+    advanceTo(QDate::currentDate());
+
+    summary.isLoaded = true;
+    summary.averageSeconds7 = static_cast<double>(m_shortWindowSeconds) / SHORT_WINDOW_DAYS;
+    summary.averageSeconds30 = static_cast<double>(m_windowSeconds) / WINDOW_DAYS;
+
+    // Today still counts as continuing a streak that ended yesterday
+    const bool streakAlive = m_lastActiveDay.isValid() && m_lastActiveDay.daysTo(m_today) <= 1;
+    summary.currentStreak = streakAlive ? m_streak : 0;
+    summary.longestStreak = m_longestStreak;
+
+    QList<int> goalIds = m_thisWeek.keys() + m_lastWeek.keys();
+    std::sort(goalIds.begin(), goalIds.end());
+    goalIds.erase(std::unique(goalIds.begin(), goalIds.end()), goalIds.end());
+
+    for (int goalId : goalIds) {
+        GoalTrend trend;
+        trend.goalId = goalId;
+        trend.thisWeekSeconds = m_thisWeek.value(goalId);
+        trend.lastWeekSeconds = m_lastWeek.value(goalId);
+        summary.goalTrends.append(trend);
+    }
+    std::stable_sort(summary.goalTrends.begin(), summary.goalTrends.end(),
+                     [](const GoalTrend& a, const GoalTrend& b) {
+                         return a.thisWeekSeconds > b.thisWeekSeconds;
+                     });
+
+    return summary;
+}
+
+void FocusTrends::recordSession(const DatabaseManager::TimerRecord& record)
+{
+    // A load in flight may or may not have read this session, so it is read again
+    if (m_isLoading) {
+        m_reloadQueued = true;
+        return;
+    }
+
+    // Not loaded yet: the first load reads it from the rollup
+    if (!m_isLoaded) {
+        return;
+    }
+
+    // Cut at midnight like the rollup, so each day gets its own share
+    const QDate firstDay = record.startTime.date();
+    const IntervalSplitter splitter(firstDay, 1);
+    splitter.split(record.startTime, record.endTime, [this, &firstDay, &record](int day, qint64 seconds) {
+        addSeconds(firstDay.addDays(day), record.goalId, seconds);
+    });
+}
+
+void FocusTrends::load()
+{
+    if (m_isLoading) {
+        m_reloadQueued = true;
+        return;
+    }
+    m_isLoading = true;
+
+    // One row per day and goal, so even years of history are a few thousand rows.
+    // Earlier results stay in place until the new ones are folded
+    DatabaseExecutor::deliver(DatabaseExecutor::instance().getDailyGoalTotals(QDate(1970, 1, 1), QDate::currentDate()),
+                              this, [this](const QList<DatabaseManager::DailyGoalTotal>& totals) {
+        m_isLoading = false;
+        if (m_reloadQueued) {
+            m_reloadQueued = false;
+            load();
+            return;
+        }
+
+        // Rows arrive ordered by day, which is all the streak needs
+        reset();
+        for (const auto& total : totals) {
+            addSeconds(total.day, total.goalId, total.seconds);
+        }
+        m_isLoaded = true;
+
+        emit loaded();
+    });
+}
+
+void FocusTrends::reset()
+{
+    m_today = QDate();
+    m_days.fill(0);
+    m_shortWindowSeconds = 0;
+    m_windowSeconds = 0;
+
+    m_lastActiveDay = QDate();
+    m_streak = 0;
+    m_longestStreak = 0;
+
+    m_weekStart = QDate();
+    m_thisWeek.clear();
+    m_lastWeek.clear();
+}
+
+void FocusTrends::onDataChanged(const DatabaseManager::ChangeSet& changes)
+{
+    // New sessions were folded in by recordSession(); anything else rewrites history
+    bool historyChanged = false;
+    for (const auto& event : changes.events) {
+        if ((event.entity == DatabaseManager::Entity::TimerRecord && event.operation != DatabaseManager::Operation::Added) ||
+            (event.entity == DatabaseManager::Entity::Goal && event.operation == DatabaseManager::Operation::Removed)) {
+            historyChanged = true;
+            break;
+        }
+    }
+
+    if (historyChanged && (m_isLoaded || m_isLoading)) {
+        load();
+    }
+}
+
+void FocusTrends::advanceTo(const QDate& today)
+{
+    if (!m_today.isValid()) {
+        m_today = today;
+        m_weekStart = StatisticsPeriod::weekStart(today);
+        return;
+    }
+
+    if (today <= m_today) {
+        return;
+    }
+
+    // Each new day pushes the oldest one out of both windows
+    if (m_today.daysTo(today) >= WINDOW_DAYS) {
+        m_days.fill(0);
+        m_shortWindowSeconds = 0;
+        m_windowSeconds = 0;
+    } else {
+        for (QDate day = m_today.addDays(1); day <= today; day = day.addDays(1)) {
+            m_shortWindowSeconds -= daySeconds(day.addDays(-SHORT_WINDOW_DAYS));
+            qint64& expired = daySeconds(day);
+            m_windowSeconds -= expired;
+            expired = 0;
+        }
+    }
+    m_today = today;
+
+    const QDate newWeekStart = StatisticsPeriod::weekStart(today);
+    if (newWeekStart != m_weekStart) {
+        if (newWeekStart == m_weekStart.addDays(7)) {
+            m_lastWeek = m_thisWeek;
+        } else {
+            m_lastWeek.clear();
+        }
+        m_thisWeek.clear();
+        m_weekStart = newWeekStart;
+    }
+}
+
+void FocusTrends::addSeconds(const QDate& day, int goalId, qint64 seconds)
+{
+    if (seconds <= 0) {
+        return;
+    }
+
+    advanceTo(day);
+
+    const qint64 age = day.daysTo(m_today);
+    if (age < WINDOW_DAYS) {
+        daySeconds(day) += seconds;
+        m_windowSeconds += seconds;
+        if (age < SHORT_WINDOW_DAYS) {
+            m_shortWindowSeconds += seconds;
+        }
+    }
+
+    if (!m_lastActiveDay.isValid() || day > m_lastActiveDay) {
+        const bool continues = m_lastActiveDay.isValid() && m_lastActiveDay.daysTo(day) == 1;
+        m_streak = continues ? m_streak + 1 : 1;
+        m_longestStreak = qMax(m_longestStreak, m_streak);
+        m_lastActiveDay = day;
+    }
+
+    const QDate dayWeekStart = StatisticsPeriod::weekStart(day);
+    if (dayWeekStart == m_weekStart) {
+        m_thisWeek[goalId] += seconds;
+    } else if (dayWeekStart == m_weekStart.addDays(-7)) {
+        m_lastWeek[goalId] += seconds;
+    }
+}
+
+qint64& FocusTrends::daySeconds(const QDate& day)
+{
+    return m_days[static_cast<size_t>(day.toJulianDay() % WINDOW_DAYS)];
+}
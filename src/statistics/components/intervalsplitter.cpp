@@ -0,0 +1,25 @@
+#include "statistics/components/intervalsplitter.h"
+#include <QTime>
+
+IntervalSplitter::IntervalSplitter(const QDate& firstDay, int slotsPerDay)
+    : m_firstDay(firstDay)
+    , m_slotsPerDay(slotsPerDay)
+{
+}
+
+int IntervalSplitter::bucketOf(const QDateTime& time) const
+{
+    return static_cast<int>(m_firstDay.daysTo(time.date())) * m_slotsPerDay +
+           time.time().hour() * m_slotsPerDay / 24;
+}
+
+qint64 IntervalSplitter::slotEnd(const QDate& day, int slot) const
+{
+    // Built from the local date and hour, so days shortened or lengthened by a
+    // daylight saving change still end at midnight. startOfDay() also covers zones
+    // where that change skips midnight itself
+    if (slot + 1 == m_slotsPerDay) {
+        return day.addDays(1).startOfDay().toSecsSinceEpoch();
+    }
+    return QDateTime(day, QTime((slot + 1) * 24 / m_slotsPerDay, 0)).toSecsSinceEpoch();
+}
@@ -0,0 +1,228 @@
+#include "statistics/components/statisticsactivityviewwidget.h"
+#include "statistics/components/statisticsheatmapwidget.h"
+#include "statistics/components/statisticsdatamanager.h"
+#include <QHBoxLayout>
+#include <QMap>
+#include <QPainter>
+#include <QPainterPath>
+#include <QLinearGradient>
+#include <QSet>
+#include <QStringList>
+#include <algorithm>
+
+StatisticsActivityViewWidget::StatisticsActivityViewWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_mainLayout(nullptr)
+    , m_titleLabel(nullptr)
+    , m_goalComboBox(nullptr)
+    , m_summaryLabel(nullptr)
+    , m_scrollArea(nullptr)
+    , m_heatmap(nullptr)
+    , m_trendsLabel(nullptr)
+    , m_goalTrendsLabel(nullptr)
+{
+    setupUi();
+}
+
+void StatisticsActivityViewWidget::paintEvent(QPaintEvent* event)
+{
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // Create rounded rectangle path
+    QPainterPath path;
+    path.addRoundedRect(rect(), 15, 15);
+
+    // Create gradient
+    QLinearGradient gradient(0, 0, 0, height());
+    gradient.setColorAt(0, QColor(255, 245, 245)); // #FFF5F5
+    gradient.setColorAt(1, QColor(255, 232, 232)); // #FFE8E8
+
+    // Fill with gradient
+    painter.fillPath(path, gradient);
+
+    // Draw border
+    painter.setPen(QPen(QColor(255, 208, 208), 1)); // #FFD0D0
+    painter.drawPath(path);
+
+    QWidget::paintEvent(event);
+}
+
+void StatisticsActivityViewWidget::setupUi()
+{
+    // Set transparent background so our custom paint shows through
+    setAutoFillBackground(false);
+
+    m_mainLayout = new QVBoxLayout(this);
+    m_mainLayout->setSpacing(15);
+    m_mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    // Header layout with title, goal picker and summary
+    QHBoxLayout* headerLayout = new QHBoxLayout();
+    headerLayout->setSpacing(10);
+
+    // Title
+    m_titleLabel = new QLabel("Activity", this);
+    QFont titleFont = m_titleLabel->font();
+    titleFont.setPointSize(18);
+    titleFont.setWeight(QFont::Bold);
+    m_titleLabel->setFont(titleFont);
+    m_titleLabel->setStyleSheet("QLabel { color: #A64545; background-color: transparent; }");
+
+    m_goalComboBox = new QComboBox(this);
+    m_goalComboBox->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    m_goalComboBox->addItem("All goals", ALL_GOALS);
+
+    // Summary
+    m_summaryLabel = new QLabel(this);
+    QFont summaryFont = m_summaryLabel->font();
+    summaryFont.setPointSize(12);
+    summaryFont.setWeight(QFont::Medium);
+    m_summaryLabel->setFont(summaryFont);
+    m_summaryLabel->setStyleSheet("QLabel { color: #6c757d; background-color: transparent; }");
+    m_summaryLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+    headerLayout->addWidget(m_titleLabel);
+    headerLayout->addWidget(m_goalComboBox);
+    headerLayout->addStretch();
+    headerLayout->addWidget(m_summaryLabel);
+
+    m_mainLayout->addLayout(headerLayout);
+
+    // Scrolls sideways when the page is narrower than a year of weeks
+    m_scrollArea = new QScrollArea(this);
+    m_scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    m_scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_scrollArea->setAlignment(Qt::AlignCenter);
+    m_scrollArea->setStyleSheet(
+        "QScrollArea {"
+        "   border: none;"
+        "   background-color: transparent;"
+        "}"
+    );
+
+    m_heatmap = new StatisticsHeatmapWidget();
+    m_heatmap->setStyleSheet("QWidget { background-color: transparent; }");
+
+    m_scrollArea->setWidget(m_heatmap);
+    m_scrollArea->setMinimumHeight(m_heatmap->height() + 20);
+    m_mainLayout->addWidget(m_scrollArea);
+
+    // Averages and streak on one line, then one line per goal
+    m_trendsLabel = new QLabel(this);
+    m_trendsLabel->setStyleSheet("QLabel { color: #2c3e50; background-color: transparent; font-size: 12px; font-weight: 600; }");
+    m_mainLayout->addWidget(m_trendsLabel);
+
+    m_goalTrendsLabel = new QLabel(this);
+    m_goalTrendsLabel->setTextFormat(Qt::RichText);
+    m_goalTrendsLabel->setStyleSheet("QLabel { color: #6c757d; background-color: transparent; font-size: 12px; }");
+    m_mainLayout->addWidget(m_goalTrendsLabel);
+
+    connect(m_goalComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &StatisticsActivityViewWidget::onGoalSelected);
+}
+
+void StatisticsActivityViewWidget::setDailyTotals(const QList<DatabaseManager::DailyGoalTotal>& totals,
+                                                  const QDate& lastDay)
+{
+    m_totals = totals;
+    m_lastDay = lastDay;
+
+    updateGoalChoices();
+    updateHeatmap();
+}
+
+void StatisticsActivityViewWidget::setTrends(const FocusTrends::Summary& summary)
+{
+    if (!summary.isLoaded) {
+        m_trendsLabel->clear();
+        m_goalTrendsLabel->clear();
+        return;
+    }
+
+    m_trendsLabel->setText(QString("7-day average: %1 • 30-day average: %2 • Streak: %3 days (longest %4)")
+                               .arg(StatisticsDataManager::formatHours(summary.averageSeconds7 / 3600.0))
+                               .arg(StatisticsDataManager::formatHours(summary.averageSeconds30 / 3600.0))
+                               .arg(summary.currentStreak)
+                               .arg(summary.longestStreak));
+
+    QStringList lines;
+    for (const auto& trend : summary.goalTrends) {
+        const DatabaseManager::GoalItem goal = DatabaseManager::instance().getGoal(trend.goalId);
+        const QString title = (goal.id != -1 ? goal.title : QString("No Goal")).toHtmlEscaped();
+
+        QString change = "new this week";
+        if (trend.lastWeekSeconds > 0) {
+            const int percent = qRound((trend.thisWeekSeconds - trend.lastWeekSeconds) * 100.0 / trend.lastWeekSeconds);
+            change = QString("<span style=\"color: %1;\">%2%3%</span> vs last week")
+                         .arg(percent >= 0 ? "#27ae60" : "#e74c3c")
+                         .arg(percent >= 0 ? "+" : "")
+                         .arg(percent);
+        }
+
+        lines << QString("<b>%1</b>: %2 this week, %3")
+                     .arg(title)
+                     .arg(StatisticsDataManager::formatHours(trend.thisWeekSeconds / 3600.0))
+                     .arg(change);
+    }
+    m_goalTrendsLabel->setText(lines.join("<br/>"));
+}
+
+void StatisticsActivityViewWidget::onGoalSelected()
+{
+    updateHeatmap();
+}
+
+void StatisticsActivityViewWidget::updateGoalChoices()
+{
+    QSet<int> goalIds;
+    for (const auto& total : m_totals) {
+        goalIds.insert(total.goalId);
+    }
+
+    QList<int> sortedIds = goalIds.values();
+    std::sort(sortedIds.begin(), sortedIds.end());
+
+    // Rebuilt quietly; the selected goal stays selected while it has any sessions
+    const int selectedId = m_goalComboBox->currentData().toInt();
+    m_goalComboBox->blockSignals(true);
+    m_goalComboBox->clear();
+    m_goalComboBox->addItem("All goals", ALL_GOALS);
+    for (int goalId : sortedIds) {
+        const DatabaseManager::GoalItem goal = DatabaseManager::instance().getGoal(goalId);
+        m_goalComboBox->addItem(goal.id != -1 ? goal.title : "No Goal", goalId);
+    }
+    m_goalComboBox->setCurrentIndex(qMax(0, m_goalComboBox->findData(selectedId)));
+    m_goalComboBox->blockSignals(false);
+}
+
+void StatisticsActivityViewWidget::updateHeatmap()
+{
+    const int selectedId = m_goalComboBox->currentData().toInt();
+
+    QMap<QDate, int> secondsPerDay;
+    for (const auto& total : m_totals) {
+        if (selectedId == ALL_GOALS || total.goalId == selectedId) {
+            secondsPerDay[total.day] += total.seconds;
+        }
+    }
+
+    QColor color("#FF6B6B");
+    if (selectedId == DatabaseManager::NO_GOAL_ID) {
+        color = QColor("#C0C0C0");
+    } else if (selectedId != ALL_GOALS) {
+        color = DatabaseManager::instance().getGoalColor(selectedId);
+    }
+
+    m_heatmap->setDays(secondsPerDay, m_lastDay, color);
+
+    qint64 totalSeconds = 0;
+    int activeDays = 0;
+    for (int seconds : secondsPerDay) {
+        totalSeconds += seconds;
+        activeDays += seconds > 0 ? 1 : 0;
+    }
+    m_summaryLabel->setText(QString("Total: %1 across %2 days")
+                                .arg(StatisticsDataManager::formatHours(totalSeconds / 3600.0))
+                                .arg(activeDays));
+}
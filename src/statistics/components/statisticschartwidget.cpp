@@ -0,0 +1,370 @@
+#include "statistics/components/statisticschartwidget.h"
+#include <QEasingCurve>
+#include <QFontMetrics>
+#include <QHash>
+#include <QHelpEvent>
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QStringList>
+#include <QToolTip>
+#include <cmath>
+
+StatisticsChartWidget::StatisticsChartWidget(Orientation orientation, QWidget* parent)
+    : QWidget(parent)
+    , m_orientation(orientation)
+    , m_maxHours(1.0)
+    , m_hoveredIndex(-1)
+    , m_animation(new QVariantAnimation(this))
+    , m_progress(1.0)
+{
+    setMouseTracking(true);
+
+    m_animation->setStartValue(0.0);
+    m_animation->setEndValue(1.0);
+    m_animation->setDuration(250);
+    m_animation->setEasingCurve(QEasingCurve::OutCubic);
+
+    connect(m_animation, &QVariantAnimation::valueChanged, this, [this](const QVariant& value) {
+        m_progress = value.toDouble();
+        update(m_animatedRect);
+    });
+}
+
+void StatisticsChartWidget::setBars(const QList<Bar>& bars, double maxHours)
+{
+    QHash<QString, int> previousIndex;
+    QStringList previousLabels;
+    for (int i = 0; i < m_bars.size(); ++i) {
+        previousIndex.insert(m_bars[i].label, i);
+        previousLabels << m_bars[i].label;
+    }
+
+    QStringList labels;
+    QList<double> startHours;
+    QList<bool> changed;
+    for (const Bar& bar : bars) {
+        labels << bar.label;
+        auto previous = previousIndex.constFind(bar.label);
+        if (previous == previousIndex.constEnd()) {
+            startHours << 0.0;
+            changed << true;
+        } else {
+            startHours << displayedHours(*previous);
+            changed << !sameSegments(m_bars[*previous].segments, bar.segments);
+        }
+    }
+
+    const double newMaxHours = maxHours > 0 ? maxHours : 1.0;
+    const bool sameLayout = labels == previousLabels && newMaxHours == m_maxHours;
+
+    m_bars = bars;
+    m_startHours = startHours;
+    m_maxHours = newMaxHours;
+    m_hoveredIndex = -1;
+    updateGeometry();
+
+    // Same bars on the same scale: only those with different data are repainted
+    m_animatedRect = QRect();
+    if (sameLayout) {
+        for (int i = 0; i < m_bars.size(); ++i) {
+            if (changed[i]) {
+                m_animatedRect |= barRect(i);
+            }
+        }
+    } else {
+        m_animatedRect = rect();
+    }
+
+    m_animation->stop();
+    if (m_animatedRect.isEmpty()) {
+        m_progress = 1.0;
+        return;
+    }
+
+    m_progress = 0.0;
+    m_animation->start();
+    update(m_animatedRect);
+}
+
+QSize StatisticsChartWidget::sizeHint() const
+{
+    return minimumSizeHint().expandedTo(QSize(300, 300));
+}
+
+QSize StatisticsChartWidget::minimumSizeHint() const
+{
+    const int count = m_bars.size();
+    if (m_orientation == Orientation::Vertical) {
+        const int contentWidth = count * (BAR_WIDTH + 2 * MARGIN) + qMax(0, count - 1) * PADDING;
+        return QSize(contentWidth + 2 * PADDING, 200);
+    }
+
+    const int contentHeight = count * (BAR_HEIGHT + 2 * MARGIN) + qMax(0, count - 1) * 10;
+    return QSize(300, contentHeight + 2 * PADDING);
+}
+
+void StatisticsChartWidget::paintEvent(QPaintEvent* event)
+{
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    for (int i = 0; i < m_bars.size(); ++i) {
+        const QRect card = barRect(i);
+        if (!event->rect().intersects(card)) {
+            continue;
+        }
+
+        // Card with a soft shadow underneath
+        const bool hovered = i == m_hoveredIndex;
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(0, 0, 0, m_orientation == Orientation::Vertical ? 15 : 20));
+        painter.drawRoundedRect(card.translated(0, 2), 12, 12);
+
+        if (m_orientation == Orientation::Vertical) {
+            painter.setPen(hovered ? QPen(QColor("#FF6B6B"), 2) : QPen(QColor("#e0e0e0"), 1));
+        } else {
+            painter.setPen(QPen(QColor(hovered ? "#d0d0d0" : "#e0e0e0"), 1));
+        }
+        painter.setBrush(QColor(hovered ? "#fefefe" : "#ffffff"));
+        painter.drawRoundedRect(card, 12, 12);
+
+        painter.save();
+        painter.translate(card.topLeft());
+        if (m_orientation == Orientation::Vertical) {
+            paintVerticalBar(painter, i);
+        } else {
+            paintHorizontalBar(painter, i);
+        }
+        painter.restore();
+    }
+}
+
+void StatisticsChartWidget::paintVerticalBar(QPainter& painter, int index) const
+{
+    const Bar& bar = m_bars[index];
+    const QRect rect(QPoint(0, 0), barRect(index).size());
+
+    QRect totalTimeRect(0, 0, rect.width(), TOTAL_TIME_HEIGHT);
+    QRect labelRect(0, rect.height() - DATE_LABEL_HEIGHT, rect.width(), DATE_LABEL_HEIGHT);
+    QRect barArea(MARGIN, TOTAL_TIME_HEIGHT + MARGIN, rect.width() - 2 * MARGIN,
+                  rect.height() - DATE_LABEL_HEIGHT - TOTAL_TIME_HEIGHT - 3 * MARGIN);
+
+    // Draw date label at bottom
+    painter.setPen(QPen(QColor("#2c3e50"), 1));
+    QFont labelFont = font();
+    labelFont.setPointSize(9);
+    labelFont.setWeight(QFont::Medium);
+    painter.setFont(labelFont);
+    painter.drawText(labelRect, Qt::AlignCenter, bar.label);
+
+    const double total = totalHours(bar);
+
+    // Draw total time at the top if there are segments
+    if (total > 0) {
+        QFont totalFont = font();
+        totalFont.setPointSize(11);
+        totalFont.setWeight(QFont::Bold);
+        painter.setFont(totalFont);
+        painter.drawText(totalTimeRect, Qt::AlignCenter, formatHours(total));
+    }
+
+    // Draw bar background
+    painter.setPen(QPen(QColor("#e0e0e0"), 1));
+    painter.setBrush(QBrush(QColor("#f8f9fa")));
+    painter.drawRoundedRect(barArea, 4, 4);
+
+    if (total <= 0) {
+        return;
+    }
+
+    // Square root scale keeps short days visible next to long ones
+    const double shownHours = displayedHours(index);
+    const double usedBarHeight = sqrt(shownHours) / sqrt(m_maxHours) * barArea.height();
+
+    double currentY = barArea.bottom();
+    for (const auto& segment : bar.segments) {
+        if (segment.hours <= 0) continue;
+
+        double segmentHeight = segment.hours / total * usedBarHeight;
+        segmentHeight = qMax(segmentHeight, 3.0);
+
+        QRectF segmentRect(barArea.left(), currentY - segmentHeight, barArea.width(), segmentHeight);
+
+        painter.setPen(QPen(segment.color.darker(110), 1));
+        painter.setBrush(QBrush(segment.color));
+        painter.drawRoundedRect(segmentRect, 2, 2);
+
+        currentY -= segmentHeight;
+    }
+}
+
+void StatisticsChartWidget::paintHorizontalBar(QPainter& painter, int index) const
+{
+    const Bar& bar = m_bars[index];
+    const QRect rect(QPoint(0, 0), barRect(index).size());
+
+    QRect labelRect(MARGIN, 0, LABEL_WIDTH - MARGIN, rect.height());
+    QRect barArea(LABEL_WIDTH + MARGIN, MARGIN,
+                  rect.width() - LABEL_WIDTH - 2 * MARGIN,
+                  rect.height() - 2 * MARGIN);
+
+    // Draw label
+    painter.setPen(QPen(QColor("#2c3e50"), 1));
+    QFont labelFont = font();
+    labelFont.setPointSize(11);
+    labelFont.setWeight(QFont::Medium);
+    painter.setFont(labelFont);
+    painter.drawText(labelRect, Qt::AlignLeft | Qt::AlignVCenter, bar.label);
+
+    // Draw bar background
+    painter.setPen(QPen(QColor("#e0e0e0"), 1));
+    painter.setBrush(QBrush(QColor("#f8f9fa")));
+    painter.drawRoundedRect(barArea, 4, 4);
+
+    const double hours = totalHours(bar);
+    if (hours <= 0 || bar.segments.isEmpty()) {
+        return;
+    }
+
+    const QColor color = bar.segments.first().color;
+    const int fillWidth = static_cast<int>(displayedHours(index) / m_maxHours * barArea.width());
+    QRect fillRect(barArea.left(), barArea.top(), fillWidth, barArea.height());
+
+    painter.setPen(QPen(color.darker(110), 1));
+    painter.setBrush(QBrush(color));
+    painter.drawRoundedRect(fillRect, 4, 4);
+
+    QFont timeFont = font();
+    timeFont.setPointSize(10);
+    timeFont.setWeight(QFont::Bold);
+    painter.setFont(timeFont);
+
+    // Only draw text if there's enough space, with a shadow for readability
+    const QString timeText = formatHours(hours);
+    if (fillWidth > QFontMetrics(timeFont).boundingRect(timeText).width() + 10) {
+        painter.setPen(QPen(QColor("#000000"), 1));
+        painter.drawText(fillRect.adjusted(1, 1, 1, 1), Qt::AlignCenter, timeText);
+        painter.setPen(QPen(QColor("#ffffff"), 1));
+        painter.drawText(fillRect, Qt::AlignCenter, timeText);
+    }
+}
+
+bool StatisticsChartWidget::event(QEvent* event)
+{
+    if (event->type() == QEvent::ToolTip) {
+        auto* helpEvent = static_cast<QHelpEvent*>(event);
+        const int index = barAt(helpEvent->pos());
+
+        if (m_orientation == Orientation::Vertical && index >= 0 && !m_bars[index].segments.isEmpty()) {
+            const Bar& bar = m_bars[index];
+            QString tooltip = QString("<b>%1</b><br/>").arg(bar.label);
+
+            for (const auto& segment : bar.segments) {
+                tooltip += QString("• %1: %2h<br/>")
+                          .arg(segment.goalTitle)
+                          .arg(segment.hours, 0, 'f', 1);
+            }
+
+            tooltip += QString("<b>Total: %1h</b>").arg(totalHours(bar), 0, 'f', 1);
+            QToolTip::showText(helpEvent->globalPos(), tooltip, this, barRect(index));
+        } else {
+            QToolTip::hideText();
+        }
+        return true;
+    }
+    return QWidget::event(event);
+}
+
+void StatisticsChartWidget::mouseMoveEvent(QMouseEvent* event)
+{
+    setHoveredIndex(barAt(event->pos()));
+    QWidget::mouseMoveEvent(event);
+}
+
+void StatisticsChartWidget::leaveEvent(QEvent* event)
+{
+    setHoveredIndex(-1);
+    QWidget::leaveEvent(event);
+}
+
+void StatisticsChartWidget::setHoveredIndex(int index)
+{
+    if (index == m_hoveredIndex) {
+        return;
+    }
+
+    // The hover border is drawn just outside the card's shadow offset
+    if (m_hoveredIndex >= 0) {
+        update(barRect(m_hoveredIndex).adjusted(-2, -2, 2, 4));
+    }
+    m_hoveredIndex = index;
+    if (m_hoveredIndex >= 0) {
+        update(barRect(m_hoveredIndex).adjusted(-2, -2, 2, 4));
+    }
+}
+
+QRect StatisticsChartWidget::barRect(int index) const
+{
+    if (m_orientation == Orientation::Vertical) {
+        // Centered while they fit, scrolled by the enclosing scroll area otherwise
+        const int cardWidth = BAR_WIDTH + 2 * MARGIN;
+        const int contentWidth = minimumSizeHint().width() - 2 * PADDING;
+        const int left = qMax(PADDING, (width() - contentWidth) / 2);
+        return QRect(left + index * (cardWidth + PADDING), PADDING, cardWidth, height() - 2 * PADDING);
+    }
+
+    const int cardHeight = BAR_HEIGHT + 2 * MARGIN;
+    return QRect(PADDING, PADDING + index * (cardHeight + 10), width() - 2 * PADDING, cardHeight);
+}
+
+int StatisticsChartWidget::barAt(const QPoint& pos) const
+{
+    for (int i = 0; i < m_bars.size(); ++i) {
+        if (barRect(i).contains(pos)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+double StatisticsChartWidget::displayedHours(int index) const
+{
+    const double target = totalHours(m_bars[index]);
+    return m_startHours[index] + (target - m_startHours[index]) * m_progress;
+}
+
+double StatisticsChartWidget::totalHours(const Bar& bar)
+{
+    double total = 0.0;
+    for (const auto& segment : bar.segments) {
+        if (segment.hours > 0) {
+            total += segment.hours;
+        }
+    }
+    return total;
+}
+
+QString StatisticsChartWidget::formatHours(double hours)
+{
+    if (hours < 1.0) {
+        return QString("%1m").arg(static_cast<int>(hours * 60));
+    } else if (hours < 10.0) {
+        return QString("%1h").arg(QString::number(hours, 'f', 1));
+    }
+    return QString("%1h").arg(static_cast<int>(hours));
+}
+
+bool StatisticsChartWidget::sameSegments(const QList<Segment>& a, const QList<Segment>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    for (int i = 0; i < a.size(); ++i) {
+        if (a[i].hours != b[i].hours || a[i].color != b[i].color || a[i].goalTitle != b[i].goalTitle) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -1,159 +1,389 @@
 #include "statistics/components/statisticsdatamanager.h"
+#include "database/databaseexecutor.h"
 #include <QDebug>
 #include <QMap>
 #include <QStringList>
 #include <QApplication>
 #include <QDateTime>
-#include <QSet>
+#include <QtConcurrent>
+#include <algorithm>
 #include <cmath>
 
 StatisticsDataManager::StatisticsDataManager(QObject* parent)
     : QObject(parent)
     , m_maxHours(0.0)
     , m_maxVerticalHours(0.0)
-    , m_refreshTimer(new QTimer(this))
+    , m_lastRecordId(0)
+    , m_needsRebuild(true)
+    , m_isRefreshing(false)
+    , m_refreshQueued(false)
+    , m_goalsChanged(false)
+    , m_generation(0)
+    , m_isComputing(false)
+    , m_resultCache(RESULT_CACHE_SIZE)
+    , m_cacheVersion(0)
+    , m_hasQuery(false)
+    , m_queryGeneration(0)
 {
-    m_refreshTimer->setSingleShot(true);
-    m_refreshTimer->setInterval(100);
-    connect(m_refreshTimer, &QTimer::timeout, this, &StatisticsDataManager::dataRefreshed);
 }
 
 void StatisticsDataManager::refreshFromDatabase()
 {
-    // Get all timer records from the beginning of time to now
-    QDateTime start = QDateTime::fromMSecsSinceEpoch(0);
-    QDateTime end = QDateTime::currentDateTime();
+    // One request at a time: a newer one must see the id the current one ends on
+    if (m_isRefreshing) {
+        m_refreshQueued = true;
+        return;
+    }
+    m_isRefreshing = true;
 
-    m_timerRecords = DatabaseManager::instance().getTimerRecords(start, end);
-    m_goals = DatabaseManager::instance().getAllGoals(true);
-    m_refreshTimer->start();
+    const bool rebuild = m_needsRebuild;
+    m_needsRebuild = false;
+    if (rebuild) {
+        m_lastRecordId = 0;
+    }
+
+    // Only rows stored since the last refresh are read, unless history was rewritten.
+    // The scan runs on the executor; the previous data stays on screen until it finishes
+    DatabaseExecutor::deliver(DatabaseExecutor::instance().getTimerRecordsAfter(m_lastRecordId), this,
+                              [this, rebuild](const QList<DatabaseManager::TimerRecord>& records) {
+        if (rebuild) {
+            m_index.rebuild(records);
+            m_columns.rebuild(records);
+        } else {
+            for (const auto& record : records) {
+                m_index.addRecord(record);
+            }
+            m_columns.append(records);
+        }
+
+        // Goal titles and colors appear in every period; new sessions only in their own
+        const bool goalsChanged = m_goalsChanged;
+        if (rebuild || goalsChanged) {
+            invalidateCache();
+        } else if (!records.isEmpty()) {
+            invalidateCache(records);
+        }
+        m_goalsChanged = false;
+
+        // Rows arrive ordered by id
+        if (!records.isEmpty()) {
+            m_lastRecordId = records.last().id;
+        }
+        m_isRefreshing = false;
+
+        reloadGoals();
+        emit dataRefreshed();
+
+        if (m_hasQuery && (rebuild || goalsChanged || !records.isEmpty())) {
+            runQuery(m_query);
+        }
+
+        if (m_refreshQueued) {
+            m_refreshQueued = false;
+            refreshFromDatabase();
+        }
+    });
 }
 
-void StatisticsDataManager::loadTimeBasedStatistics(const QString& rangeType, const QDate& referenceDate)
+void StatisticsDataManager::loadDailyTotals()
 {
-    QDate startDate = getPeriodStartDate(rangeType, referenceDate);
-    QDate endDate = getPeriodEndDate(rangeType, referenceDate);
+    // The rollup is kept up to date by triggers, so this never touches timer_records
+    const QDate today = QDate::currentDate();
+    DatabaseExecutor::deliver(DatabaseExecutor::instance().getDailyGoalTotals(today.addDays(1 - DAILY_TOTALS_DAYS), today),
+                              this, [this, today](const QList<DatabaseManager::DailyGoalTotal>& totals) {
+        emit dailyTotalsLoaded(totals, today);
+    });
+}
 
-    QStringList expectedGroups = getExpectedTimeGroups(rangeType, startDate, endDate);
-    QMap<QString, QList<StatisticsVerticalBarWidget::Segment>> groupedData;
+void StatisticsDataManager::runQuery(const TimerAggregation::Query& query)
+{
+    m_query = query;
+    m_hasQuery = true;
+    const quint64 generation = ++m_queryGeneration;
+
+    // The columns are shared with the worker, not copied
+    const TimerRecordColumns columns = m_columns;
+    QFuture<TimerAggregation::Result> future = QtConcurrent::run([columns, query]() {
+        return TimerAggregation::run(columns, query);
+    });
+
+    DatabaseExecutor::deliver(future, this, [this, generation](const TimerAggregation::Result& result) {
+        if (generation == m_queryGeneration) {
+            emit queryFinished(result);
+        }
+    });
+}
 
-    // Initialize all expected groups
-    for (const QString& group : expectedGroups) {
-        groupedData[group] = QList<StatisticsVerticalBarWidget::Segment>();
+void StatisticsDataManager::noteChanges(const DatabaseManager::ChangeSet& changes)
+{
+    // New sessions and goal edits are picked up incrementally. Removing a goal
+    // detaches its sessions and clearing removes them, which only a rebuild undoes
+    for (const auto& event : changes.events) {
+        if (event.entity == DatabaseManager::Entity::Todo) {
+            continue;
+        }
+        if (event.entity == DatabaseManager::Entity::Goal) {
+            m_goalsChanged = true;
+        }
+        if (event.operation == DatabaseManager::Operation::Added ||
+            (event.entity == DatabaseManager::Entity::Goal &&
+             event.operation == DatabaseManager::Operation::Updated)) {
+            continue;
+        }
+        m_needsRebuild = true;
+        return;
     }
+}
 
-    // Group timer records by time periods
-    for (const auto& record : m_timerRecords) {
-        QDate recordDate = record.startTime.date();
-        QTime recordTime = record.startTime.time();
-
-        if (recordDate >= startDate && recordDate <= endDate) {
-            QString groupLabel = getTimeGroupLabel(recordDate, recordTime, rangeType, referenceDate);
-
-            // Find the corresponding goal
-            QString goalTitle = "No Goal";
-            QColor goalColor = QColor("#C0C0C0");
-            int goalId = -1;
-
-            for (const auto& goal : m_goals) {
-                if (goal.id == record.goalId) {
-                    goalTitle = goal.title;
-                    goalColor = QColor(goal.colorCode.isEmpty() ? "#FF6B6B" : goal.colorCode);
-                    goalId = goal.id;
-                    break;
-                }
-            }
+void StatisticsDataManager::reloadGoals()
+{
+    // Served from the goal cache
+    m_goals = DatabaseManager::instance().getAllGoals(true);
+
+    m_goalsById.clear();
+    for (const auto& goal : m_goals) {
+        m_goalsById.insert(goal.id, goal);
+    }
+}
 
-            StatisticsVerticalBarWidget::Segment segment;
-            segment.label = groupLabel;
-            segment.goalTitle = goalTitle;
-            segment.hours = record.startTime.secsTo(record.endTime) / 3600.0; // Convert seconds to hours
-            segment.color = goalColor;
-            segment.goalId = goalId;
+void StatisticsDataManager::loadStatistics(const StatisticsPeriod& period)
+{
+    // Supersedes whatever is queued or running; only the newest request is delivered
+    m_request = period;
+    ++m_generation;
+
+    if (const Result* cached = m_resultCache.object(cacheKey(period))) {
+        emitResult(*cached);
+        prefetchNeighbours(m_request);
+        return;
+    }
 
-            groupedData[groupLabel].append(segment);
-        }
+    if (!m_isComputing) {
+        emit busyChanged(true);
+        startComputation();
     }
+}
+
+void StatisticsDataManager::startComputation()
+{
+    m_isComputing = true;
 
-    // Consolidate segments by goal within each group
-    for (auto it = groupedData.begin(); it != groupedData.end(); ++it) {
-        QMap<int, StatisticsVerticalBarWidget::Segment> consolidatedSegments;
+    // Copies share their data until the GUI thread writes, so the worker sees a stable index
+    const Snapshot snapshot{m_index, m_goals, m_goalsById};
+    const StatisticsPeriod request = m_request;
+    const quint64 generation = m_generation;
 
-        for (const auto& segment : it.value()) {
-            if (consolidatedSegments.contains(segment.goalId)) {
-                consolidatedSegments[segment.goalId].hours += segment.hours;
+    const quint64 cacheVersion = m_cacheVersion;
+
+    QFuture<Result> future = QtConcurrent::run([snapshot, request]() {
+        return computeStatistics(snapshot, request);
+    });
+
+    DatabaseExecutor::deliver(future, this, [this, request, generation, cacheVersion](const Result& result) {
+        m_isComputing = false;
+        if (cacheVersion == m_cacheVersion) {
+            m_resultCache.insert(cacheKey(request), new Result(result));
+        }
+
+        // Navigated on while computing: drop this period and compute the latest one,
+        // unless it is cached by now (possibly by this very result)
+        if (generation != m_generation) {
+            if (const Result* cached = m_resultCache.object(cacheKey(m_request))) {
+                emitResult(*cached);
+                emit busyChanged(false);
+                prefetchNeighbours(m_request);
             } else {
-                consolidatedSegments[segment.goalId] = segment;
+                startComputation();
             }
+            return;
         }
 
-        it.value().clear();
-        for (const auto& segment : consolidatedSegments) {
-            it.value().append(segment);
+        emitResult(result);
+        emit busyChanged(false);
+        prefetchNeighbours(request);
+    });
+}
+
+void StatisticsDataManager::prefetchNeighbours(const StatisticsPeriod& period)
+{
+    const Snapshot snapshot{m_index, m_goals, m_goalsById};
+
+    for (int step : {-1, 1}) {
+        const StatisticsPeriod neighbour = period.shifted(step);
+        const QString key = cacheKey(neighbour);
+        if (m_resultCache.contains(key) || m_prefetching.contains(key)) {
+            continue;
+        }
+
+        m_prefetching.insert(key);
+        const quint64 cacheVersion = m_cacheVersion;
+
+        QFuture<Result> future = QtConcurrent::run([snapshot, neighbour]() {
+            return computeStatistics(snapshot, neighbour);
+        });
+
+        DatabaseExecutor::deliver(future, this, [this, key, cacheVersion](const Result& result) {
+            m_prefetching.remove(key);
+            if (cacheVersion == m_cacheVersion) {
+                m_resultCache.insert(key, new Result(result));
+            }
+        });
+    }
+}
+
+void StatisticsDataManager::emitResult(const Result& result)
+{
+    m_maxVerticalHours = result.maxVerticalHours;
+    m_maxHours = result.maxHours;
+    emit timeBasedDataLoaded(result.timeBasedData, result.timeBasedSummary);
+    emit goalDataLoaded(result.goalData, result.goalSummary);
+}
+
+void StatisticsDataManager::invalidateCache()
+{
+    m_resultCache.clear();
+    ++m_cacheVersion;
+}
+
+void StatisticsDataManager::invalidateCache(const QList<DatabaseManager::TimerRecord>& records)
+{
+    QSet<QDate> days;
+    for (const auto& record : records) {
+        // Every day the session overlaps gets a share of its time
+        for (QDate day = record.startTime.date(); day <= record.endTime.date(); day = day.addDays(1)) {
+            days.insert(day);
+        }
+    }
+
+    for (const QString& key : m_resultCache.keys()) {
+        const QStringList dates = key.split('/');
+        const StatisticsPeriod period = StatisticsPeriod::custom(QDate::fromString(dates.value(0), Qt::ISODate),
+                                                                 QDate::fromString(dates.value(1), Qt::ISODate));
+        const bool affected = std::any_of(days.cbegin(), days.cend(),
+                                          [&period](const QDate& day) { return period.contains(day); });
+        if (affected) {
+            m_resultCache.remove(key);
         }
     }
 
-    // Calculate maximum hours for scaling
-    m_maxVerticalHours = 0.0;
-    for (auto it = groupedData.begin(); it != groupedData.end(); ++it) {
+    // Results still being computed may predate these records
+    ++m_cacheVersion;
+}
+
+QString StatisticsDataManager::cacheKey(const StatisticsPeriod& period)
+{
+    // Results depend on the days alone; a custom week is the same as a weekly period
+    return period.startDate.toString(Qt::ISODate) + '/' + period.endDate.toString(Qt::ISODate);
+}
+
+StatisticsDataManager::Result StatisticsDataManager::computeStatistics(const Snapshot& snapshot, const StatisticsPeriod& period)
+{
+    Result result;
+    computeTimeBasedStatistics(snapshot, period, result);
+    computeGoalStatistics(snapshot, period, result);
+    return result;
+}
+
+void StatisticsDataManager::computeTimeBasedStatistics(const Snapshot& snapshot, const StatisticsPeriod& period,
+                                                       Result& result)
+{
+    const QDate startDate = period.startDate;
+    const QDate endDate = period.endDate;
+
+    const QList<TimeGroup> groups = getTimeGroups(period);
+    const QList<int> goalIds = snapshot.index.goalIds();
+
+    QList<QPair<QString, QList<StatisticsChartWidget::Segment>>> outputData;
+    result.maxVerticalHours = 0.0;
+
+    for (const TimeGroup& group : groups) {
+        // One segment per goal; sessions of deleted goals join "No Goal"
+        QMap<int, StatisticsChartWidget::Segment> consolidatedSegments;
+
+        for (int goalId : goalIds) {
+            const bool bySlot = group.slot >= 0;
+            const int sessions = bySlot
+                ? snapshot.index.goalSlotSessions(goalId, group.startDate, group.slot)
+                : snapshot.index.goalSessions(goalId, group.startDate, group.endDate);
+            const qint64 seconds = bySlot
+                ? snapshot.index.goalSlotSeconds(goalId, group.startDate, group.slot)
+                : snapshot.index.goalSeconds(goalId, group.startDate, group.endDate);
+
+            // Sessions count where they start, so time spilling over from an earlier
+            // slot or day shows up here with none
+            if (seconds <= 0 && sessions == 0) {
+                continue;
+            }
+
+            auto goal = snapshot.goalsById.constFind(goalId);
+            const int segmentGoalId = goal != snapshot.goalsById.constEnd() ? goalId : -1;
+
+            if (consolidatedSegments.contains(segmentGoalId)) {
+                consolidatedSegments[segmentGoalId].hours += seconds / 3600.0;
+                continue;
+            }
+
+            StatisticsChartWidget::Segment segment;
+            segment.label = group.label;
+            segment.goalTitle = segmentGoalId != -1 ? goal->title : "No Goal";
+            segment.hours = seconds / 3600.0; // Convert seconds to hours
+            segment.color = segmentGoalId != -1
+                ? QColor(goal->colorCode.isEmpty() ? "#FF6B6B" : goal->colorCode)
+                : QColor("#C0C0C0");
+            segment.goalId = segmentGoalId;
+            consolidatedSegments.insert(segmentGoalId, segment);
+        }
+
         double totalHours = 0.0;
-        for (const auto& segment : it.value()) {
+        for (const auto& segment : consolidatedSegments) {
             totalHours += segment.hours;
         }
-        m_maxVerticalHours = std::max(m_maxVerticalHours, totalHours);
-    }
+        result.maxVerticalHours = std::max(result.maxVerticalHours, totalHours);
 
-    if (m_maxVerticalHours == 0.0) {
-        m_maxVerticalHours = 1.0;
+        outputData.append(qMakePair(group.label, consolidatedSegments.values()));
     }
 
-    // Convert to output format
-    QList<QPair<QString, QList<StatisticsVerticalBarWidget::Segment>>> outputData;
-    for (const QString& group : expectedGroups) {
-        outputData.append(qMakePair(group, groupedData[group]));
+    if (result.maxVerticalHours == 0.0) {
+        result.maxVerticalHours = 1.0;
     }
 
     // Generate summary
-    double totalHours = 0.0;
-    int totalSessions = 0;
-    for (const auto& record : m_timerRecords) {
-        QDate recordDate = record.startTime.date();
-        if (recordDate >= startDate && recordDate <= endDate) {
-            totalHours += record.startTime.secsTo(record.endTime) / 3600.0;
-            totalSessions++;
-        }
-    }
+    double totalHours = snapshot.index.seconds(startDate, endDate) / 3600.0;
+    int totalSessions = snapshot.index.sessions(startDate, endDate);
 
     QString summaryText = QString("Total: %1 in %2 sessions")
                          .arg(formatHours(totalHours))
                          .arg(totalSessions);
 
-    emit timeBasedDataLoaded(outputData, summaryText);
+    result.timeBasedData = outputData;
+    result.timeBasedSummary = summaryText;
 }
 
-void StatisticsDataManager::loadGoalStatistics(const QString& rangeType, const QDate& referenceDate)
+void StatisticsDataManager::computeGoalStatistics(const Snapshot& snapshot, const StatisticsPeriod& period,
+                                                  Result& result)
 {
-    QDate startDate = getPeriodStartDate(rangeType, referenceDate);
-    QDate endDate = getPeriodEndDate(rangeType, referenceDate);
+    const QDate startDate = period.startDate;
+    const QDate endDate = period.endDate;
 
     QMap<int, double> goalHours;
 
     // Calculate hours per goal (including -1 for "No Goal")
-    for (const auto& record : m_timerRecords) {
-        QDate recordDate = record.startTime.date();
-        if (recordDate >= startDate && recordDate <= endDate) {
-            goalHours[record.goalId] += record.startTime.secsTo(record.endTime) / 3600.0;
+    for (int goalId : snapshot.index.goalIds()) {
+        // Time carried over from before the period counts even without a session
+        const qint64 seconds = snapshot.index.goalSeconds(goalId, startDate, endDate);
+        if (seconds > 0 || snapshot.index.goalSessions(goalId, startDate, endDate) > 0) {
+            goalHours[goalId] = seconds / 3600.0;
         }
     }
 
     // Find maximum hours for scaling
-    m_maxHours = 0.0;
+    result.maxHours = 0.0;
     for (auto it = goalHours.begin(); it != goalHours.end(); ++it) {
-        m_maxHours = std::max(m_maxHours, it.value());
+        result.maxHours = std::max(result.maxHours, it.value());
     }
 
-    if (m_maxHours == 0.0) {
-        m_maxHours = 1.0;
+    if (result.maxHours == 0.0) {
+        result.maxHours = 1.0;
     }
 
     // Convert to output format
@@ -162,7 +392,7 @@ void StatisticsDataManager::loadGoalStatistics(const QString& rangeType, const Q
     int activeGoals = 0;
 
     // First, add all goals that have recorded time
-    for (const auto& goal : m_goals) {
+    for (const auto& goal : snapshot.goals) {
         if (goalHours.contains(goal.id)) {
             double hours = goalHours[goal.id];
             QColor goalColor = QColor(goal.colorCode.isEmpty() ? "#FF6B6B" : goal.colorCode);
@@ -182,22 +412,12 @@ void StatisticsDataManager::loadGoalStatistics(const QString& rangeType, const Q
 
     for (auto it = goalHours.begin(); it != goalHours.end(); ++it) {
         int goalId = it.key();
-        if (goalId != -1) {
-            bool foundInGoals = false;
-            for (const auto& goal : m_goals) {
-                if (goal.id == goalId) {
-                    foundInGoals = true;
-                    break;
-                }
-            }
-
-            if (!foundInGoals) {
-                double hours = it.value();
-                QColor unknownGoalColor = QColor("#999999");
-                outputData.append(qMakePair(QString("No Goal (%1)").arg(goalId), qMakePair(hours, unknownGoalColor)));
-                totalHours += hours;
-                activeGoals++;
-            }
+        if (goalId != -1 && !snapshot.goalsById.contains(goalId)) {
+            double hours = it.value();
+            QColor unknownGoalColor = QColor("#999999");
+            outputData.append(qMakePair(QString("No Goal (%1)").arg(goalId), qMakePair(hours, unknownGoalColor)));
+            totalHours += hours;
+            activeGoals++;
         }
     }
 
@@ -212,10 +432,11 @@ void StatisticsDataManager::loadGoalStatistics(const QString& rangeType, const Q
                          .arg(formatHours(totalHours))
                          .arg(activeGoals);
 
-    emit goalDataLoaded(outputData, summaryText);
+    result.goalData = outputData;
+    result.goalSummary = summaryText;
 }
 
-QString StatisticsDataManager::formatHours(double hours) const
+QString StatisticsDataManager::formatHours(double hours)
 {
     if (hours == 0) {
         return "0h";
@@ -226,113 +447,39 @@ QString StatisticsDataManager::formatHours(double hours) const
     return QString("%1h %2m").arg(floor(hours)).arg(qRound((hours - floor(hours)) * 60));
 }
 
-QString StatisticsDataManager::getTimeGroupLabel(const QDate& recordDate, const QString& rangeType, const QDate& referenceDate) const
+template <StatisticsBucketSize Size>
+QList<StatisticsDataManager::TimeGroup> StatisticsDataManager::getBucketGroups(const StatisticsPeriod& period)
 {
-    if (rangeType == "daily") {
-        return recordDate.toString("MMM d");
-    } else if (rangeType == "weekly") {
-        return recordDate.toString("ddd");
-    } else if (rangeType == "monthly") {
-        // For monthly view, group by weeks
-        int weekOfYear = recordDate.weekNumber();
-        return QString("Week %1").arg(weekOfYear);
+    // Buckets cut at the period edges, so the first and last week or month may be partial
+    QList<TimeGroup> groups;
+    QDate date = period.startDate;
+    while (date <= period.endDate) {
+        const QDate bucketEnd = qMin(StatisticsBucket<Size>::end(date), period.endDate);
+        groups.append({StatisticsBucket<Size>::label(date, period), date, bucketEnd});
+        date = bucketEnd.addDays(1);
     }
-    return recordDate.toString("MMM d");
-}
-
-QString StatisticsDataManager::getTimeGroupLabel(const QDate& recordDate, const QTime& recordTime, const QString& rangeType, const QDate& referenceDate) const
-{
-    if (rangeType == "daily") {
-        // For daily view, group by 3-hour periods
-        int hour = recordTime.hour();
-        int periodStart = (hour / 3) * 3;
-        int periodEnd = periodStart + 3;
-
-        // Handle the last period of the day
-        if (periodEnd > 24) {
-            periodEnd = 24;
-        }
-
-        return QString("%1-%2").arg(periodStart).arg(periodEnd);
-    } else if (rangeType == "weekly") {
-        // For weekly view, group by days of the week
-        return recordDate.toString("ddd");
-    } else if (rangeType == "monthly") {
-        // For monthly view, group by weeks
-        int weekOfYear = recordDate.weekNumber();
-        return QString("Week %1").arg(weekOfYear);
-    }
-
-    return recordDate.toString("MMM d");
-}
-
-QColor StatisticsDataManager::getColorForTimeGroup(const QString& label, const QString& rangeType, const QDate& referenceDate) const
-{
-    QStringList colors = {"#FF6B6B", "#4ECDC4", "#45B7D1", "#96CEB4", "#FFEAA7", "#DDA0DD", "#98D8C8", "#F7DC6F"};
-    uint hash = qHash(label);
-    return QColor(colors[hash % colors.size()]);
-}
-
-QDate StatisticsDataManager::getPeriodStartDate(const QString& rangeType, const QDate& referenceDate) const
-{
-    if (rangeType == "daily") {
-        return referenceDate;
-    } else if (rangeType == "weekly") {
-        return referenceDate.addDays(-(referenceDate.dayOfWeek() - 1));
-    } else if (rangeType == "monthly") {
-        return QDate(referenceDate.year(), referenceDate.month(), 1);
-    }
-    return referenceDate;
+    return groups;
 }
 
-QDate StatisticsDataManager::getPeriodEndDate(const QString& rangeType, const QDate& referenceDate) const
+QList<StatisticsDataManager::TimeGroup> StatisticsDataManager::getTimeGroups(const StatisticsPeriod& period)
 {
-    if (rangeType == "daily") {
-        return referenceDate;
-    } else if (rangeType == "weekly") {
-        return getPeriodStartDate(rangeType, referenceDate).addDays(6);
-    } else if (rangeType == "monthly") {
-        return QDate(referenceDate.year(), referenceDate.month(), referenceDate.daysInMonth());
+    switch (period.bucketSize()) {
+    case StatisticsBucketSize::Slot:
+        break;
+    case StatisticsBucketSize::Day:
+        return getBucketGroups<StatisticsBucketSize::Day>(period);
+    case StatisticsBucketSize::Week:
+        return getBucketGroups<StatisticsBucketSize::Week>(period);
+    case StatisticsBucketSize::Month:
+        return getBucketGroups<StatisticsBucketSize::Month>(period);
     }
-    return referenceDate;
-}
-
-QStringList StatisticsDataManager::getExpectedTimeGroups(const QString& rangeType, const QDate& startDate, const QDate& endDate) const
-{
-    QStringList groups;
-
-    if (rangeType == "daily") {
-        // For daily view, show 3-hour periods: 0-3, 3-6, 6-9, 9-12, 12-15, 15-18, 18-21, 21-24
-        for (int hour = 0; hour < 24; hour += 3) {
-            int periodEnd = hour + 3;
-            if (periodEnd > 24) {
-                periodEnd = 24;
-            }
-            groups.append(QString("%1-%2").arg(hour).arg(periodEnd));
-        }
-    } else if (rangeType == "weekly") {
-        // For weekly view, show days of the week: Monday, Tuesday, Wednesday, Thursday, Friday, Saturday, Sunday
-        QDate date = startDate;
-        while (date <= endDate) {
-            groups.append(date.toString("ddd"));
-            date = date.addDays(1);
-        }
-    } else if (rangeType == "monthly") {
-        // For monthly view, show weeks: Week 1, Week 2, etc.
-        QSet<int> weekNumbers;
-        QDate date = startDate;
-        while (date <= endDate) {
-            weekNumbers.insert(date.weekNumber());
-            date = date.addDays(1);
-        }
-
-        QList<int> sortedWeeks(weekNumbers.begin(), weekNumbers.end());
-        std::sort(sortedWeeks.begin(), sortedWeeks.end());
 
-        for (int week : sortedWeeks) {
-            groups.append(QString("Week %1").arg(week));
-        }
+    // 3-hour periods of a single day: 0-3, 3-6, 6-9, 9-12, 12-15, 15-18, 18-21, 21-24
+    QList<TimeGroup> groups;
+    for (int slot = 0; slot < StatisticsIndex::SLOTS_PER_DAY; ++slot) {
+        int hour = slot * StatisticsIndex::HOURS_PER_SLOT;
+        groups.append({QString("%1-%2").arg(hour).arg(hour + StatisticsIndex::HOURS_PER_SLOT),
+                       period.startDate, period.startDate, slot});
     }
-    
     return groups;
 }
\ No newline at end of file
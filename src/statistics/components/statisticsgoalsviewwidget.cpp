@@ -1,5 +1,4 @@
 #include "statistics/components/statisticsgoalsviewwidget.h"
-#include "statistics/statisticswidget.h"
 #include <QPainter>
 #include <QPainterPath>
 #include <QLinearGradient>
@@ -10,9 +9,7 @@ StatisticsGoalsViewWidget::StatisticsGoalsViewWidget(QWidget* parent)
     , m_titleLabel(nullptr)
     , m_summaryLabel(nullptr)
     , m_scrollArea(nullptr)
-    , m_barsContainer(nullptr)
-    , m_barsLayout(nullptr)
-    , m_maxHours(0.0)
+    , m_chart(nullptr)
 {
     setupUi();
 }
@@ -90,30 +87,24 @@ void StatisticsGoalsViewWidget::setupUi()
         "}"
     );
 
-    m_barsContainer = new QWidget();
-    m_barsContainer->setStyleSheet("QWidget { background-color: transparent; }");
-    m_barsLayout = new QVBoxLayout(m_barsContainer);
-    m_barsLayout->setSpacing(10);
-    m_barsLayout->setContentsMargins(15, 15, 15, 15);
-    m_barsLayout->setAlignment(Qt::AlignTop);
+    // All bars are painted by one chart widget
+    m_chart = new StatisticsChartWidget(StatisticsChartWidget::Orientation::Horizontal);
+    m_chart->setStyleSheet("QWidget { background-color: transparent; }");
 
-    m_scrollArea->setWidget(m_barsContainer);
+    m_scrollArea->setWidget(m_chart);
     m_mainLayout->addWidget(m_scrollArea);
 }
 
-void StatisticsGoalsViewWidget::clearBars()
+void StatisticsGoalsViewWidget::setBars(const QList<QPair<QString, QPair<double, QColor>>>& data, double maxHours)
 {
-    QLayoutItem* item;
-    while ((item = m_barsLayout->takeAt(0)) != nullptr) {
-        delete item->widget();
-        delete item;
+    // One single-segment bar per goal
+    QList<StatisticsChartWidget::Bar> bars;
+    for (const auto& barData : data) {
+        StatisticsChartWidget::Segment segment{barData.first, barData.first, barData.second.first,
+                                               barData.second.second, -1};
+        bars.append({barData.first, {segment}});
     }
-}
-
-void StatisticsGoalsViewWidget::addBar(const QString& label, double hours, const QColor& color)
-{
-    StatisticsBarWidget* barWidget = new StatisticsBarWidget(label, hours, m_maxHours, color, this);
-    m_barsLayout->addWidget(barWidget);
+    m_chart->setBars(bars, maxHours);
 }
 
 void StatisticsGoalsViewWidget::setSummaryText(const QString& text)
@@ -1,5 +1,9 @@
 #include "statistics/components/statisticsheaderwidget.h"
 #include <QAction>
+#include <QDateEdit>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QFormLayout>
 #include <QApplication>
 #include <QPainter>
 #include <QPainterPath>
@@ -18,8 +22,9 @@ StatisticsHeaderWidget::StatisticsHeaderWidget(QWidget* parent)
     , m_todayButton(nullptr)
     , m_titleLabel(nullptr)
     , m_periodLabel(nullptr)
-    , m_currentTimeRange("daily")
-    , m_currentReferenceDate(QDate::currentDate())
+    , m_busyLabel(nullptr)
+    , m_busyTimer(nullptr)
+    , m_currentPeriod(StatisticsPeriod::containing(StatisticsRangeType::Daily, QDate::currentDate()))
 {
     QLocale::setDefault(QLocale(QLocale::English));
     setupUi();
@@ -205,6 +210,16 @@ void StatisticsHeaderWidget::setupUi()
 
     rightLayout->addStretch();
 
+    // Busy indicator, hidden unless a computation outlasts m_busyTimer
+    m_busyLabel = new QLabel("Updating…");
+    m_busyLabel->setStyleSheet("QLabel { color: #B07070; background-color: transparent; font-size: 12px; }");
+    m_busyLabel->setVisible(false);
+    rightLayout->addWidget(m_busyLabel);
+
+    m_busyTimer = new QTimer(this);
+    m_busyTimer->setSingleShot(true);
+    m_busyTimer->setInterval(150);
+
     // Selected date label
     m_periodLabel = new QLabel();
     QFont periodFont = m_periodLabel->font();
@@ -251,26 +266,29 @@ void StatisticsHeaderWidget::setupTimeRangeMenu()
     m_timeRangeMenu = new QMenu(this);
     m_timeRangeActionGroup = new QActionGroup(this);
 
-    QAction* dailyAction = new QAction("Daily", this);
-    dailyAction->setCheckable(true);
-    dailyAction->setChecked(true);
-    dailyAction->setData("daily");
-
-    QAction* weeklyAction = new QAction("Weekly", this);
-    weeklyAction->setCheckable(true);
-    weeklyAction->setData("weekly");
-
-    QAction* monthlyAction = new QAction("Monthly", this);
-    monthlyAction->setCheckable(true);
-    monthlyAction->setData("monthly");
-
-    m_timeRangeActionGroup->addAction(dailyAction);
-    m_timeRangeActionGroup->addAction(weeklyAction);
-    m_timeRangeActionGroup->addAction(monthlyAction);
-
-    m_timeRangeMenu->addAction(dailyAction);
-    m_timeRangeMenu->addAction(weeklyAction);
-    m_timeRangeMenu->addAction(monthlyAction);
+    const QList<StatisticsRangeType> rangeTypes = {
+        StatisticsRangeType::Daily,
+        StatisticsRangeType::Weekly,
+        StatisticsRangeType::Monthly,
+        StatisticsRangeType::Yearly,
+        StatisticsRangeType::Custom,
+    };
+
+    for (StatisticsRangeType rangeType : rangeTypes) {
+        QString text = StatisticsPeriod::rangeTypeName(rangeType);
+        if (rangeType == StatisticsRangeType::Custom) {
+            text += "...";
+            m_timeRangeMenu->addSeparator();
+        }
+
+        QAction* action = new QAction(text, this);
+        action->setCheckable(true);
+        action->setChecked(rangeType == m_currentPeriod.rangeType);
+        action->setData(static_cast<int>(rangeType));
+
+        m_timeRangeActionGroup->addAction(action);
+        m_timeRangeMenu->addAction(action);
+    }
 
     m_timeRangeMenu->setStyleSheet(
         "QMenu {"
@@ -301,91 +319,107 @@ void StatisticsHeaderWidget::connectSignals()
     connect(m_previousButton, &QPushButton::clicked, this, &StatisticsHeaderWidget::previousPeriod);
     connect(m_nextButton, &QPushButton::clicked, this, &StatisticsHeaderWidget::nextPeriod);
     connect(m_todayButton, &QPushButton::clicked, this, &StatisticsHeaderWidget::todayClicked);
+    connect(m_busyTimer, &QTimer::timeout, m_busyLabel, &QLabel::show);
 }
 
 void StatisticsHeaderWidget::onTimeRangeMenuTriggered()
 {
     QAction* action = m_timeRangeActionGroup->checkedAction();
     if (action) {
-        m_currentTimeRange = action->data().toString();
-        m_timeRangeButton->setText(action->text());
-        updatePeriodLabel();
-        emit timeRangeChanged();
+        setCurrentTimeRange(static_cast<StatisticsRangeType>(action->data().toInt()));
     }
 }
 
-void StatisticsHeaderWidget::setCurrentTimeRange(const QString& range)
+void StatisticsHeaderWidget::setCurrentTimeRange(StatisticsRangeType rangeType)
 {
-    m_currentTimeRange = range;
-    QString buttonText = range;
-    buttonText[0] = buttonText[0].toUpper();
-    m_timeRangeButton->setText(buttonText);
+    if (rangeType == StatisticsRangeType::Custom) {
+        // Cancelling the dialog keeps the current period
+        if (!pickCustomPeriod()) {
+            checkTimeRangeAction(m_currentPeriod.rangeType);
+            return;
+        }
+    } else {
+        // Stay on today when it is shown, otherwise on the first day shown
+        const QDate today = QDate::currentDate();
+        const QDate referenceDate = m_currentPeriod.contains(today) ? today : m_currentPeriod.startDate;
+        m_currentPeriod = StatisticsPeriod::containing(rangeType, referenceDate);
+    }
+
+    checkTimeRangeAction(rangeType);
+    m_timeRangeButton->setText(StatisticsPeriod::rangeTypeName(rangeType));
     updatePeriodLabel();
+    updateNavigationButtons();
+    emit timeRangeChanged();
 }
 
-void StatisticsHeaderWidget::setCurrentReferenceDate(const QDate& date)
+void StatisticsHeaderWidget::setCurrentPeriod(const StatisticsPeriod& period)
 {
-    m_currentReferenceDate = date;
+    m_currentPeriod = period;
     updatePeriodLabel();
 }
 
-void StatisticsHeaderWidget::updateNavigationButtons()
+bool StatisticsHeaderWidget::pickCustomPeriod()
 {
-    QDate today = QDate::currentDate();
-    QDate periodStart = getPeriodStartDate(m_currentTimeRange, today);
-    QDate currentPeriodStart = getPeriodStartDate(m_currentTimeRange, m_currentReferenceDate);
+    QDialog dialog(this);
+    dialog.setWindowTitle("Custom Range");
+
+    QDateEdit* startEdit = new QDateEdit(m_currentPeriod.startDate, &dialog);
+    QDateEdit* endEdit = new QDateEdit(m_currentPeriod.endDate, &dialog);
+    for (QDateEdit* edit : {startEdit, endEdit}) {
+        edit->setCalendarPopup(true);
+        edit->setDisplayFormat("MMM d, yyyy");
+        edit->setMaximumDate(QDate::currentDate());
+    }
 
-    bool isCurrentPeriod = (currentPeriodStart == periodStart);
-    m_nextButton->setEnabled(!isCurrentPeriod);
-    m_todayButton->setEnabled(!isCurrentPeriod);
-}
+    // The end never precedes the start
+    endEdit->setMinimumDate(startEdit->date());
+    connect(startEdit, &QDateEdit::dateChanged, endEdit, &QDateEdit::setMinimumDate);
 
-void StatisticsHeaderWidget::updatePeriodLabel()
-{
-    QLocale locale(QLocale::English);
+    QDialogButtonBox* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+    connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+
+    QFormLayout* layout = new QFormLayout(&dialog);
+    layout->addRow("From:", startEdit);
+    layout->addRow("To:", endEdit);
+    layout->addRow(buttons);
 
-    QString periodText = getPeriodDisplayName(m_currentTimeRange, m_currentReferenceDate);
-    m_periodLabel->setText(periodText);
+    if (dialog.exec() != QDialog::Accepted) {
+        return false;
+    }
+
+    m_currentPeriod = StatisticsPeriod::custom(startEdit->date(), endEdit->date());
+    return true;
 }
 
-QString StatisticsHeaderWidget::getPeriodDisplayName(const QString& rangeType, const QDate& referenceDate) const
+void StatisticsHeaderWidget::checkTimeRangeAction(StatisticsRangeType rangeType)
 {
-    QLocale locale(QLocale::English);
-
-    if (rangeType == "daily") {
-        return locale.toString(referenceDate, "MMMM d, yyyy");
-    } else if (rangeType == "weekly") {
-        QDate weekStart = getPeriodStartDate(rangeType, referenceDate);
-        QDate weekEnd = getPeriodEndDate(rangeType, referenceDate);
-        return locale.toString(weekStart, "MMM d") + " - " +
-               locale.toString(weekEnd, "MMM d, yyyy");
-    } else if (rangeType == "monthly") {
-        return locale.toString(referenceDate, "MMMM yyyy");
+    for (QAction* action : m_timeRangeActionGroup->actions()) {
+        if (action->data().toInt() == static_cast<int>(rangeType)) {
+            action->setChecked(true);
+        }
     }
+}
 
-    return "";
+void StatisticsHeaderWidget::updateNavigationButtons()
+{
+    // Nothing is recorded after today
+    bool isCurrentPeriod = m_currentPeriod.endDate >= QDate::currentDate();
+    m_nextButton->setEnabled(!isCurrentPeriod);
+    m_todayButton->setEnabled(!isCurrentPeriod);
 }
 
-QDate StatisticsHeaderWidget::getPeriodStartDate(const QString& rangeType, const QDate& referenceDate) const
+void StatisticsHeaderWidget::updatePeriodLabel()
 {
-    if (rangeType == "daily") {
-        return referenceDate;
-    } else if (rangeType == "weekly") {
-        return referenceDate.addDays(-(referenceDate.dayOfWeek() - 1));
-    } else if (rangeType == "monthly") {
-        return QDate(referenceDate.year(), referenceDate.month(), 1);
-    }
-    return referenceDate;
+    m_periodLabel->setText(m_currentPeriod.displayName());
 }
 
-QDate StatisticsHeaderWidget::getPeriodEndDate(const QString& rangeType, const QDate& referenceDate) const
+void StatisticsHeaderWidget::setBusy(bool busy)
 {
-    if (rangeType == "daily") {
-        return referenceDate;
-    } else if (rangeType == "weekly") {
-        return getPeriodStartDate(rangeType, referenceDate).addDays(6);
-    } else if (rangeType == "monthly") {
-        return QDate(referenceDate.year(), referenceDate.month(), referenceDate.daysInMonth());
+    if (busy) {
+        m_busyTimer->start();
+    } else {
+        m_busyTimer->stop();
+        m_busyLabel->hide();
     }
-    return referenceDate;
 }
\ No newline at end of file
@@ -0,0 +1,224 @@
+#include "statistics/components/statisticsheatmapwidget.h"
+#include "statistics/components/statisticsdatamanager.h"
+#include <QHelpEvent>
+#include <QLocale>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QToolTip>
+
+StatisticsHeatmapWidget::StatisticsHeatmapWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_lastDay(QDate::currentDate())
+    , m_color("#FF6B6B")
+    , m_maxSeconds(0)
+    , m_pixmapValid(false)
+{
+    setFixedSize(sizeHint());
+}
+
+void StatisticsHeatmapWidget::setDays(const QMap<QDate, int>& secondsPerDay, const QDate& lastDay,
+                                      const QColor& color)
+{
+    int maxSeconds = 0;
+    for (int seconds : secondsPerDay) {
+        maxSeconds = qMax(maxSeconds, seconds);
+    }
+
+    // Shades are relative to the busiest day, so a new maximum reshades every cell
+    const bool sameShading = m_pixmapValid && lastDay == m_lastDay && color == m_color &&
+                             maxSeconds == m_maxSeconds;
+
+    if (sameShading) {
+        auto markChanged = [this](const QDate& day) {
+            const QRect cell = cellRect(day);
+            if (cell.isValid()) {
+                m_dirtyDays.insert(day);
+                update(cell);
+            }
+        };
+
+        for (auto it = secondsPerDay.cbegin(); it != secondsPerDay.cend(); ++it) {
+            if (m_secondsPerDay.value(it.key()) != it.value()) {
+                markChanged(it.key());
+            }
+        }
+        for (auto it = m_secondsPerDay.cbegin(); it != m_secondsPerDay.cend(); ++it) {
+            if (!secondsPerDay.contains(it.key())) {
+                markChanged(it.key());
+            }
+        }
+    }
+
+    m_secondsPerDay = secondsPerDay;
+    m_lastDay = lastDay;
+    m_color = color;
+    m_maxSeconds = maxSeconds;
+
+    if (!sameShading) {
+        invalidatePixmap();
+    }
+}
+
+QSize StatisticsHeatmapWidget::sizeHint() const
+{
+    return minimumSizeHint();
+}
+
+QSize StatisticsHeatmapWidget::minimumSizeHint() const
+{
+    return QSize(LEFT_MARGIN + WEEKS * (CELL_SIZE + CELL_SPACING) - CELL_SPACING,
+                 TOP_MARGIN + 7 * (CELL_SIZE + CELL_SPACING) - CELL_SPACING);
+}
+
+void StatisticsHeatmapWidget::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    if (!m_pixmapValid || m_pixmap.devicePixelRatioF() != devicePixelRatioF()) {
+        renderPixmap();
+    } else if (!m_dirtyDays.isEmpty()) {
+        QPainter pixmapPainter(&m_pixmap);
+        pixmapPainter.setRenderHint(QPainter::Antialiasing);
+        for (const QDate& day : m_dirtyDays) {
+            pixmapPainter.setCompositionMode(QPainter::CompositionMode_Source);
+            pixmapPainter.fillRect(cellRect(day), Qt::transparent);
+            pixmapPainter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+            paintCell(pixmapPainter, day);
+        }
+        m_dirtyDays.clear();
+    }
+
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, m_pixmap);
+}
+
+bool StatisticsHeatmapWidget::event(QEvent* event)
+{
+    if (event->type() == QEvent::ToolTip) {
+        auto* helpEvent = static_cast<QHelpEvent*>(event);
+        const QDate day = dayAt(helpEvent->pos());
+
+        if (day.isValid()) {
+            const QString tooltip = QString("<b>%1</b><br/>%2")
+                                        .arg(day.toString("MMM d, yyyy"))
+                                        .arg(StatisticsDataManager::formatHours(m_secondsPerDay.value(day) / 3600.0));
+            QToolTip::showText(helpEvent->globalPos(), tooltip, this, cellRect(day));
+        } else {
+            QToolTip::hideText();
+        }
+        return true;
+    }
+    return QWidget::event(event);
+}
+
+void StatisticsHeatmapWidget::invalidatePixmap()
+{
+    m_pixmapValid = false;
+    m_dirtyDays.clear();
+    update();
+}
+
+void StatisticsHeatmapWidget::renderPixmap()
+{
+    const qreal ratio = devicePixelRatioF();
+    m_pixmap = QPixmap(size() * ratio);
+    m_pixmap.setDevicePixelRatio(ratio);
+    m_pixmap.fill(Qt::transparent);
+
+    QPainter painter(&m_pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    paintLabels(painter);
+    for (QDate day = firstDay(); day <= m_lastDay; day = day.addDays(1)) {
+        paintCell(painter, day);
+    }
+
+    m_pixmapValid = true;
+    m_dirtyDays.clear();
+}
+
+void StatisticsHeatmapWidget::paintCell(QPainter& painter, const QDate& day) const
+{
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(levelColor(levelOf(m_secondsPerDay.value(day))));
+    painter.drawRoundedRect(cellRect(day), 2, 2);
+}
+
+void StatisticsHeatmapWidget::paintLabels(QPainter& painter) const
+{
+    QFont labelFont = font();
+    labelFont.setPointSize(8);
+    painter.setFont(labelFont);
+    painter.setPen(QColor("#6c757d"));
+
+    // Monday, Wednesday and Friday rows
+    for (int row : {0, 2, 4}) {
+        const QRect cell = cellRect(firstDay().addDays(row));
+        painter.drawText(QRect(0, cell.top() - 2, LEFT_MARGIN - CELL_SPACING, CELL_SIZE + 4),
+                         Qt::AlignRight | Qt::AlignVCenter, QLocale().dayName(row + 1, QLocale::ShortFormat));
+    }
+
+    // Month names above the first week starting in that month
+    for (int week = 1; week < WEEKS; ++week) {
+        const QDate monday = firstDay().addDays(7 * week);
+        if (monday.month() != monday.addDays(-7).month()) {
+            const QRect cell = cellRect(monday);
+            painter.drawText(QRect(cell.left(), 0, 4 * (CELL_SIZE + CELL_SPACING), TOP_MARGIN - 4),
+                             Qt::AlignLeft | Qt::AlignBottom, monday.toString("MMM"));
+        }
+    }
+}
+
+QDate StatisticsHeatmapWidget::firstDay() const
+{
+    // The last column is the week holding m_lastDay, every column starts on a Monday
+    return m_lastDay.addDays(1 - m_lastDay.dayOfWeek() - 7 * (WEEKS - 1));
+}
+
+QRect StatisticsHeatmapWidget::cellRect(const QDate& day) const
+{
+    const qint64 offset = firstDay().daysTo(day);
+    if (offset < 0 || day > m_lastDay) {
+        return QRect();
+    }
+
+    const int week = static_cast<int>(offset / 7);
+    const int weekday = day.dayOfWeek() - 1;
+    return QRect(LEFT_MARGIN + week * (CELL_SIZE + CELL_SPACING),
+                 TOP_MARGIN + weekday * (CELL_SIZE + CELL_SPACING), CELL_SIZE, CELL_SIZE);
+}
+
+QDate StatisticsHeatmapWidget::dayAt(const QPoint& pos) const
+{
+    const int week = (pos.x() - LEFT_MARGIN) / (CELL_SIZE + CELL_SPACING);
+    const int weekday = (pos.y() - TOP_MARGIN) / (CELL_SIZE + CELL_SPACING);
+    if (pos.x() < LEFT_MARGIN || pos.y() < TOP_MARGIN || week >= WEEKS || weekday >= 7) {
+        return QDate();
+    }
+
+    const QDate day = firstDay().addDays(7 * week + weekday);
+    return cellRect(day).contains(pos) ? day : QDate();
+}
+
+int StatisticsHeatmapWidget::levelOf(int seconds) const
+{
+    if (seconds <= 0 || m_maxSeconds <= 0) {
+        return 0;
+    }
+
+    // Quarters of the busiest day, rounded up so any focused time shows
+    const qint64 level = (static_cast<qint64>(seconds) * LEVELS + m_maxSeconds - 1) / m_maxSeconds;
+    return static_cast<int>(qBound<qint64>(1, level, LEVELS));
+}
+
+QColor StatisticsHeatmapWidget::levelColor(int level) const
+{
+    if (level == 0) {
+        return QColor("#ebedf0");
+    }
+
+    // Blended towards white rather than made transparent, so the card does not tint it
+    const double strength = static_cast<double>(level) / LEVELS;
+    return QColor::fromRgbF(1.0 - (1.0 - m_color.redF()) * strength,
+                            1.0 - (1.0 - m_color.greenF()) * strength,
+                            1.0 - (1.0 - m_color.blueF()) * strength);
+}
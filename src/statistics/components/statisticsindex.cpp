@@ -0,0 +1,205 @@
+#include "statistics/components/statisticsindex.h"
+#include "statistics/components/intervalsplitter.h"
+#include <algorithm>
+
+void StatisticsIndex::rebuild(const QList<DatabaseManager::TimerRecord>& records)
+{
+    clear();
+    if (records.isEmpty()) {
+        return;
+    }
+
+    QDate firstDay = records.first().startTime.date();
+    QDate lastDay = records.first().endTime.date();
+    for (const auto& record : records) {
+        firstDay = qMin(firstDay, record.startTime.date());
+        lastDay = qMax(lastDay, record.endTime.date());
+    }
+    coverDay(firstDay);
+    coverDay(lastDay);
+
+    // Per-slot totals first, then one pass turns every series into running sums
+    const IntervalSplitter splitter(m_firstDay, SLOTS_PER_DAY);
+    for (const auto& record : records) {
+        Series& goalSeries = seriesFor(record.goalId);
+        for (Series* series : {&m_total, &goalSeries}) {
+            series->sessions[splitter.bucketOf(record.startTime) + 1] += 1;
+            splitter.split(record.startTime, record.endTime, [series](int slot, qint64 seconds) {
+                series->seconds[slot + 1] += seconds;
+            });
+        }
+    }
+
+    auto accumulate = [this](Series& series) {
+        for (int i = 1; i <= m_slotCount; ++i) {
+            series.seconds[i] += series.seconds[i - 1];
+            series.sessions[i] += series.sessions[i - 1];
+        }
+    };
+
+    accumulate(m_total);
+    for (Series& series : m_goals) {
+        accumulate(series);
+    }
+}
+
+void StatisticsIndex::addRecord(const DatabaseManager::TimerRecord& record)
+{
+    coverDay(record.startTime.date());
+    coverDay(record.endTime.date());
+
+    const IntervalSplitter splitter(m_firstDay, SLOTS_PER_DAY);
+    Series& goalSeries = seriesFor(record.goalId);
+    for (Series* series : {&m_total, &goalSeries}) {
+        addToSeries(*series, splitter.bucketOf(record.startTime), 0, 1);
+        splitter.split(record.startTime, record.endTime, [this, series](int slot, qint64 seconds) {
+            addToSeries(*series, slot, seconds, 0);
+        });
+    }
+}
+
+void StatisticsIndex::clear()
+{
+    m_firstDay = QDate();
+    m_slotCount = 0;
+    m_total = Series();
+    m_goals.clear();
+}
+
+QList<int> StatisticsIndex::goalIds() const
+{
+    QList<int> ids = m_goals.keys();
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+qint64 StatisticsIndex::seconds(const QDate& startDate, const QDate& endDate) const
+{
+    return secondsBetween(m_total, slotRange(startDate, endDate));
+}
+
+int StatisticsIndex::sessions(const QDate& startDate, const QDate& endDate) const
+{
+    return sessionsBetween(m_total, slotRange(startDate, endDate));
+}
+
+qint64 StatisticsIndex::goalSeconds(int goalId, const QDate& startDate, const QDate& endDate) const
+{
+    auto it = m_goals.constFind(goalId);
+    return it != m_goals.constEnd() ? secondsBetween(*it, slotRange(startDate, endDate)) : 0;
+}
+
+int StatisticsIndex::goalSessions(int goalId, const QDate& startDate, const QDate& endDate) const
+{
+    auto it = m_goals.constFind(goalId);
+    return it != m_goals.constEnd() ? sessionsBetween(*it, slotRange(startDate, endDate)) : 0;
+}
+
+qint64 StatisticsIndex::goalSlotSeconds(int goalId, const QDate& day, int slot) const
+{
+    auto it = m_goals.constFind(goalId);
+    return it != m_goals.constEnd() ? secondsBetween(*it, slotRange(day, slot)) : 0;
+}
+
+int StatisticsIndex::goalSlotSessions(int goalId, const QDate& day, int slot) const
+{
+    auto it = m_goals.constFind(goalId);
+    return it != m_goals.constEnd() ? sessionsBetween(*it, slotRange(day, slot)) : 0;
+}
+
+StatisticsIndex::Series& StatisticsIndex::seriesFor(int goalId)
+{
+    auto it = m_goals.find(goalId);
+    if (it == m_goals.end()) {
+        it = m_goals.insert(goalId, Series());
+        resizeSeries(*it, m_slotCount);
+    }
+    return *it;
+}
+
+void StatisticsIndex::resizeSeries(Series& series, int slotCount)
+{
+    // Slots past the old end hold no sessions, so they repeat the last running sum
+    const int oldSize = series.seconds.size();
+    const qint64 lastSeconds = oldSize > 0 ? series.seconds.last() : 0;
+    const int lastSessions = oldSize > 0 ? series.sessions.last() : 0;
+
+    series.seconds.resize(slotCount + 1);
+    series.sessions.resize(slotCount + 1);
+    std::fill(series.seconds.begin() + oldSize, series.seconds.end(), lastSeconds);
+    std::fill(series.sessions.begin() + oldSize, series.sessions.end(), lastSessions);
+}
+
+void StatisticsIndex::coverDay(const QDate& day)
+{
+    if (isEmpty()) {
+        m_firstDay = day;
+        m_slotCount = SLOTS_PER_DAY;
+        resizeSeries(m_total, m_slotCount);
+        return;
+    }
+
+    if (day < m_firstDay) {
+        // Earlier slots are empty, so the existing running sums stay valid behind them
+        const int added = static_cast<int>(day.daysTo(m_firstDay)) * SLOTS_PER_DAY;
+        auto prepend = [added](Series& series) {
+            series.seconds.insert(0, added, 0);
+            series.sessions.insert(0, added, 0);
+        };
+
+        prepend(m_total);
+        for (Series& series : m_goals) {
+            prepend(series);
+        }
+        m_firstDay = day;
+        m_slotCount += added;
+        return;
+    }
+
+    const int slotCount = static_cast<int>(m_firstDay.daysTo(day) + 1) * SLOTS_PER_DAY;
+    if (slotCount > m_slotCount) {
+        resizeSeries(m_total, slotCount);
+        for (Series& series : m_goals) {
+            resizeSeries(series, slotCount);
+        }
+        m_slotCount = slotCount;
+    }
+}
+
+void StatisticsIndex::addToSeries(Series& series, int slot, qint64 seconds, int sessions)
+{
+    for (int i = slot + 1; i <= m_slotCount; ++i) {
+        series.seconds[i] += seconds;
+        series.sessions[i] += sessions;
+    }
+}
+
+QPair<int, int> StatisticsIndex::slotRange(const QDate& startDate, const QDate& endDate) const
+{
+    if (isEmpty()) {
+        return qMakePair(0, 0);
+    }
+
+    const qint64 first = qBound<qint64>(0, m_firstDay.daysTo(startDate) * SLOTS_PER_DAY, m_slotCount);
+    const qint64 last = qBound<qint64>(first, (m_firstDay.daysTo(endDate) + 1) * SLOTS_PER_DAY, m_slotCount);
+    return qMakePair(static_cast<int>(first), static_cast<int>(last));
+}
+
+QPair<int, int> StatisticsIndex::slotRange(const QDate& day, int slot) const
+{
+    const qint64 index = isEmpty() ? -1 : m_firstDay.daysTo(day) * SLOTS_PER_DAY + slot;
+    if (index < 0 || index >= m_slotCount) {
+        return qMakePair(0, 0);
+    }
+    return qMakePair(static_cast<int>(index), static_cast<int>(index) + 1);
+}
+
+qint64 StatisticsIndex::secondsBetween(const Series& series, const QPair<int, int>& range)
+{
+    return series.seconds.at(range.second) - series.seconds.at(range.first);
+}
+
+int StatisticsIndex::sessionsBetween(const Series& series, const QPair<int, int>& range)
+{
+    return series.sessions.at(range.second) - series.sessions.at(range.first);
+}
@@ -0,0 +1,111 @@
+#include "statistics/components/statisticsperiod.h"
+#include <QLocale>
+
+StatisticsPeriod StatisticsPeriod::containing(StatisticsRangeType rangeType, const QDate& referenceDate)
+{
+    StatisticsPeriod period;
+    period.rangeType = rangeType;
+
+    switch (rangeType) {
+    case StatisticsRangeType::Weekly:
+        period.startDate = weekStart(referenceDate);
+        period.endDate = period.startDate.addDays(6);
+        break;
+    case StatisticsRangeType::Monthly:
+        period.startDate = QDate(referenceDate.year(), referenceDate.month(), 1);
+        period.endDate = QDate(referenceDate.year(), referenceDate.month(), referenceDate.daysInMonth());
+        break;
+    case StatisticsRangeType::Yearly:
+        period.startDate = QDate(referenceDate.year(), 1, 1);
+        period.endDate = QDate(referenceDate.year(), 12, 31);
+        break;
+    case StatisticsRangeType::Daily:
+    case StatisticsRangeType::Custom:
+        period.startDate = referenceDate;
+        period.endDate = referenceDate;
+        break;
+    }
+
+    return period;
+}
+
+StatisticsPeriod StatisticsPeriod::custom(const QDate& startDate, const QDate& endDate)
+{
+    StatisticsPeriod period;
+    period.rangeType = StatisticsRangeType::Custom;
+    period.startDate = qMin(startDate, endDate);
+    period.endDate = qMax(startDate, endDate);
+    return period;
+}
+
+QString StatisticsPeriod::rangeTypeName(StatisticsRangeType rangeType)
+{
+    switch (rangeType) {
+    case StatisticsRangeType::Daily:
+        return "Daily";
+    case StatisticsRangeType::Weekly:
+        return "Weekly";
+    case StatisticsRangeType::Monthly:
+        return "Monthly";
+    case StatisticsRangeType::Yearly:
+        return "Yearly";
+    case StatisticsRangeType::Custom:
+        return "Custom";
+    }
+    return QString();
+}
+
+StatisticsPeriod StatisticsPeriod::shifted(int steps) const
+{
+    switch (rangeType) {
+    case StatisticsRangeType::Daily:
+        return containing(rangeType, startDate.addDays(steps));
+    case StatisticsRangeType::Weekly:
+        return containing(rangeType, startDate.addDays(7 * steps));
+    case StatisticsRangeType::Monthly:
+        return containing(rangeType, startDate.addMonths(steps));
+    case StatisticsRangeType::Yearly:
+        return containing(rangeType, startDate.addYears(steps));
+    case StatisticsRangeType::Custom:
+        break;
+    }
+
+    const qint64 days = dayCount() * steps;
+    return custom(startDate.addDays(days), endDate.addDays(days));
+}
+
+StatisticsBucketSize StatisticsPeriod::bucketSize() const
+{
+    // At most 14 daily or 14 weekly bars; longer periods get one bar per month
+    const qint64 days = dayCount();
+    if (days <= 1) {
+        return StatisticsBucketSize::Slot;
+    } else if (days <= 14) {
+        return StatisticsBucketSize::Day;
+    } else if (days <= 92) {
+        return StatisticsBucketSize::Week;
+    }
+    return StatisticsBucketSize::Month;
+}
+
+QString StatisticsPeriod::displayName() const
+{
+    QLocale locale(QLocale::English);
+
+    switch (rangeType) {
+    case StatisticsRangeType::Daily:
+        return locale.toString(startDate, "MMMM d, yyyy");
+    case StatisticsRangeType::Weekly:
+        return locale.toString(startDate, "MMM d") + " - " +
+               locale.toString(endDate, "MMM d, yyyy");
+    case StatisticsRangeType::Monthly:
+        return locale.toString(startDate, "MMMM yyyy");
+    case StatisticsRangeType::Yearly:
+        return locale.toString(startDate, "yyyy");
+    case StatisticsRangeType::Custom:
+        break;
+    }
+
+    return locale.toString(startDate, "MMM d, yyyy") + " - " +
+           locale.toString(endDate, "MMM d, yyyy");
+}
@@ -0,0 +1,358 @@
+#include "statistics/components/statisticspivotviewwidget.h"
+#include "statistics/components/statisticsdatamanager.h"
+#include "database/databasemanager.h"
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLocale>
+#include <QPainter>
+#include <QPainterPath>
+#include <QLinearGradient>
+
+StatisticsPivotViewWidget::StatisticsPivotViewWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_mainLayout(nullptr)
+    , m_titleLabel(nullptr)
+    , m_summaryLabel(nullptr)
+    , m_rowsComboBox(nullptr)
+    , m_columnsComboBox(nullptr)
+    , m_measureComboBox(nullptr)
+    , m_goalComboBox(nullptr)
+    , m_startDateEdit(nullptr)
+    , m_endDateEdit(nullptr)
+    , m_minDurationSpinBox(nullptr)
+    , m_table(nullptr)
+{
+    setupUi();
+}
+
+void StatisticsPivotViewWidget::paintEvent(QPaintEvent* event)
+{
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // Create rounded rectangle path
+    QPainterPath path;
+    path.addRoundedRect(rect(), 15, 15);
+
+    // Create gradient
+    QLinearGradient gradient(0, 0, 0, height());
+    gradient.setColorAt(0, QColor(255, 245, 245)); // #FFF5F5
+    gradient.setColorAt(1, QColor(255, 232, 232)); // #FFE8E8
+
+    // Fill with gradient
+    painter.fillPath(path, gradient);
+
+    // Draw border
+    painter.setPen(QPen(QColor(255, 208, 208), 1)); // #FFD0D0
+    painter.drawPath(path);
+
+    QWidget::paintEvent(event);
+}
+
+void StatisticsPivotViewWidget::setupUi()
+{
+    // Set transparent background so our custom paint shows through
+    setAutoFillBackground(false);
+
+    m_mainLayout = new QVBoxLayout(this);
+    m_mainLayout->setSpacing(15);
+    m_mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    // Header layout with title and summary
+    QHBoxLayout* headerLayout = new QHBoxLayout();
+    headerLayout->setSpacing(10);
+
+    // Title
+    m_titleLabel = new QLabel("Explore", this);
+    QFont titleFont = m_titleLabel->font();
+    titleFont.setPointSize(18);
+    titleFont.setWeight(QFont::Bold);
+    m_titleLabel->setFont(titleFont);
+    m_titleLabel->setStyleSheet("QLabel { color: #A64545; background-color: transparent; }");
+
+    // Summary
+    m_summaryLabel = new QLabel(this);
+    QFont summaryFont = m_summaryLabel->font();
+    summaryFont.setPointSize(12);
+    summaryFont.setWeight(QFont::Medium);
+    m_summaryLabel->setFont(summaryFont);
+    m_summaryLabel->setStyleSheet("QLabel { color: #6c757d; background-color: transparent; }");
+    m_summaryLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+    headerLayout->addWidget(m_titleLabel);
+    headerLayout->addStretch();
+    headerLayout->addWidget(m_summaryLabel);
+
+    m_mainLayout->addLayout(headerLayout);
+
+    auto controlLabel = [this](const QString& text) {
+        QLabel* label = new QLabel(text, this);
+        label->setStyleSheet("QLabel { color: #8b5a5a; background-color: transparent; font-size: 12px; }");
+        return label;
+    };
+
+    // What the table is grouped by and what its cells show
+    QHBoxLayout* groupLayout = new QHBoxLayout();
+    groupLayout->setSpacing(10);
+
+    m_rowsComboBox = createDimensionComboBox(this);
+    m_rowsComboBox->setCurrentIndex(m_rowsComboBox->findData(static_cast<int>(TimerAggregation::Dimension::Weekday)));
+
+    m_columnsComboBox = createDimensionComboBox(this);
+    m_columnsComboBox->setCurrentIndex(m_columnsComboBox->findData(static_cast<int>(TimerAggregation::Dimension::Goal)));
+
+    m_measureComboBox = new QComboBox(this);
+    m_measureComboBox->addItem("Hours", static_cast<int>(Measure::Hours));
+    m_measureComboBox->addItem("Sessions", static_cast<int>(Measure::Sessions));
+    m_measureComboBox->addItem("Average length", static_cast<int>(Measure::AverageMinutes));
+
+    groupLayout->addWidget(controlLabel("Rows"));
+    groupLayout->addWidget(m_rowsComboBox);
+    groupLayout->addWidget(controlLabel("Columns"));
+    groupLayout->addWidget(m_columnsComboBox);
+    groupLayout->addWidget(controlLabel("Show"));
+    groupLayout->addWidget(m_measureComboBox);
+    groupLayout->addStretch();
+
+    m_mainLayout->addLayout(groupLayout);
+
+    // Which sessions are counted; this year's by default
+    QHBoxLayout* filterLayout = new QHBoxLayout();
+    filterLayout->setSpacing(10);
+
+    const QDate today = QDate::currentDate();
+    m_startDateEdit = new QDateEdit(QDate(today.year(), 1, 1), this);
+    m_startDateEdit->setCalendarPopup(true);
+    m_endDateEdit = new QDateEdit(today, this);
+    m_endDateEdit->setCalendarPopup(true);
+
+    m_goalComboBox = new QComboBox(this);
+    m_goalComboBox->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    m_goalComboBox->addItem("All goals", ALL_GOALS);
+    updateGoalChoices();
+
+    m_minDurationSpinBox = new QSpinBox(this);
+    m_minDurationSpinBox->setRange(0, 24 * 60);
+    m_minDurationSpinBox->setSingleStep(5);
+    m_minDurationSpinBox->setSuffix(" min");
+
+    filterLayout->addWidget(controlLabel("From"));
+    filterLayout->addWidget(m_startDateEdit);
+    filterLayout->addWidget(controlLabel("To"));
+    filterLayout->addWidget(m_endDateEdit);
+    filterLayout->addWidget(controlLabel("Goal"));
+    filterLayout->addWidget(m_goalComboBox);
+    filterLayout->addWidget(controlLabel("At least"));
+    filterLayout->addWidget(m_minDurationSpinBox);
+    filterLayout->addStretch();
+
+    m_mainLayout->addLayout(filterLayout);
+
+    m_table = new QTableWidget(this);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionMode(QAbstractItemView::NoSelection);
+    m_table->setFocusPolicy(Qt::NoFocus);
+    m_table->setMinimumHeight(260);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_table->setStyleSheet(
+        "QTableWidget {"
+        "   background-color: rgba(255, 255, 255, 0.8);"
+        "   border: 1px solid #FFD0D0;"
+        "   border-radius: 8px;"
+        "   gridline-color: #FFE0E0;"
+        "   color: #2c3e50;"
+        "}"
+        "QHeaderView::section {"
+        "   background-color: #FFE8E8;"
+        "   color: #8b5a5a;"
+        "   border: none;"
+        "   padding: 4px;"
+        "   font-weight: 600;"
+        "}"
+    );
+    m_mainLayout->addWidget(m_table);
+
+    for (QComboBox* comboBox : {m_rowsComboBox, m_columnsComboBox, m_goalComboBox}) {
+        connect(comboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+                this, &StatisticsPivotViewWidget::onQueryControlsChanged);
+    }
+    connect(m_startDateEdit, &QDateEdit::dateChanged, this, &StatisticsPivotViewWidget::onQueryControlsChanged);
+    connect(m_endDateEdit, &QDateEdit::dateChanged, this, &StatisticsPivotViewWidget::onQueryControlsChanged);
+    connect(m_minDurationSpinBox, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &StatisticsPivotViewWidget::onQueryControlsChanged);
+
+    // Only changes how the current result is shown
+    connect(m_measureComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &StatisticsPivotViewWidget::updateTable);
+}
+
+QComboBox* StatisticsPivotViewWidget::createDimensionComboBox(QWidget* parent)
+{
+    QComboBox* comboBox = new QComboBox(parent);
+    comboBox->addItem("Nothing", static_cast<int>(TimerAggregation::Dimension::None));
+    comboBox->addItem("Goal", static_cast<int>(TimerAggregation::Dimension::Goal));
+    comboBox->addItem("Year", static_cast<int>(TimerAggregation::Dimension::Year));
+    comboBox->addItem("Month", static_cast<int>(TimerAggregation::Dimension::Month));
+    comboBox->addItem("Weekday", static_cast<int>(TimerAggregation::Dimension::Weekday));
+    comboBox->addItem("Hour", static_cast<int>(TimerAggregation::Dimension::Hour));
+    return comboBox;
+}
+
+TimerAggregation::Query StatisticsPivotViewWidget::query() const
+{
+    TimerAggregation::Query query;
+    query.rows = static_cast<TimerAggregation::Dimension>(m_rowsComboBox->currentData().toInt());
+    query.columns = static_cast<TimerAggregation::Dimension>(m_columnsComboBox->currentData().toInt());
+    query.filter.startDate = m_startDateEdit->date();
+    query.filter.endDate = m_endDateEdit->date();
+    query.filter.minDurationSeconds = m_minDurationSpinBox->value() * 60;
+
+    const int goalId = m_goalComboBox->currentData().toInt();
+    if (goalId != ALL_GOALS) {
+        query.filter.goalIds.insert(goalId);
+    }
+
+    return query;
+}
+
+void StatisticsPivotViewWidget::onQueryControlsChanged()
+{
+    emit queryChanged(query());
+}
+
+void StatisticsPivotViewWidget::setResult(const TimerAggregation::Result& result)
+{
+    m_result = result;
+
+    // Goals may have been added or renamed since the last result
+    updateGoalChoices();
+    updateTable();
+}
+
+void StatisticsPivotViewWidget::updateGoalChoices()
+{
+    // Rebuilt quietly; the selected goal stays selected while it exists
+    const int selectedId = m_goalComboBox->currentData().toInt();
+    m_goalComboBox->blockSignals(true);
+    m_goalComboBox->clear();
+    m_goalComboBox->addItem("All goals", ALL_GOALS);
+    m_goalComboBox->addItem("No Goal", DatabaseManager::NO_GOAL_ID);
+    for (const auto& goal : DatabaseManager::instance().getAllGoals(true)) {
+        m_goalComboBox->addItem(goal.title, goal.id);
+    }
+    m_goalComboBox->setCurrentIndex(qMax(0, m_goalComboBox->findData(selectedId)));
+    m_goalComboBox->blockSignals(false);
+}
+
+void StatisticsPivotViewWidget::updateTable()
+{
+    using Dimension = TimerAggregation::Dimension;
+
+    const Dimension rows = m_result.query.rows;
+    const Dimension columns = m_result.query.columns;
+
+    // A totals row and column, unless that side is not grouped at all
+    const bool rowTotals = rows != Dimension::None;
+    const bool columnTotals = columns != Dimension::None;
+    const int rowCount = m_result.rowKeys.size() + (rowTotals ? 1 : 0);
+    const int columnCount = m_result.columnKeys.size() + (columnTotals ? 1 : 0);
+
+    m_table->clear();
+    m_table->setRowCount(m_result.total.sessions > 0 ? rowCount : 0);
+    m_table->setColumnCount(m_result.total.sessions > 0 ? columnCount : 0);
+
+    m_summaryLabel->setText(QString("%1 in %2 sessions")
+                                .arg(StatisticsDataManager::formatHours(m_result.total.seconds / 3600.0))
+                                .arg(m_result.total.sessions));
+    if (m_result.total.sessions == 0) {
+        return;
+    }
+
+    QStringList rowLabels;
+    for (int key : m_result.rowKeys) {
+        rowLabels << keyLabel(rows, key);
+    }
+    QStringList columnLabels;
+    for (int key : m_result.columnKeys) {
+        columnLabels << keyLabel(columns, key);
+    }
+    if (rowTotals) {
+        rowLabels << "Total";
+    }
+    if (columnTotals) {
+        columnLabels << "Total";
+    }
+    m_table->setVerticalHeaderLabels(rowLabels);
+    m_table->setHorizontalHeaderLabels(columnLabels);
+
+    auto setCell = [this](int row, int column, const TimerAggregation::Cell& cell, bool isTotal) {
+        QTableWidgetItem* item = new QTableWidgetItem(cellText(cell));
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        if (isTotal) {
+            QFont font = item->font();
+            font.setBold(true);
+            item->setFont(font);
+        }
+        m_table->setItem(row, column, item);
+    };
+
+    for (int row = 0; row < m_result.rowKeys.size(); ++row) {
+        const int rowKey = m_result.rowKeys.at(row);
+        for (int column = 0; column < m_result.columnKeys.size(); ++column) {
+            setCell(row, column, m_result.cells.value(qMakePair(rowKey, m_result.columnKeys.at(column))), false);
+        }
+        if (columnTotals) {
+            setCell(row, m_result.columnKeys.size(), m_result.rowTotals.value(rowKey), true);
+        }
+    }
+
+    if (rowTotals) {
+        const int row = m_result.rowKeys.size();
+        for (int column = 0; column < m_result.columnKeys.size(); ++column) {
+            setCell(row, column, m_result.columnTotals.value(m_result.columnKeys.at(column)), true);
+        }
+        if (columnTotals) {
+            setCell(row, m_result.columnKeys.size(), m_result.total, true);
+        }
+    }
+}
+
+QString StatisticsPivotViewWidget::keyLabel(TimerAggregation::Dimension dimension, int key) const
+{
+    switch (dimension) {
+    case TimerAggregation::Dimension::None:
+        return "All";
+    case TimerAggregation::Dimension::Goal: {
+        const DatabaseManager::GoalItem goal = DatabaseManager::instance().getGoal(key);
+        return goal.id != -1 ? goal.title : "No Goal";
+    }
+    case TimerAggregation::Dimension::Year:
+        return QString::number(key);
+    case TimerAggregation::Dimension::Month:
+        return QLocale().monthName(key, QLocale::ShortFormat);
+    case TimerAggregation::Dimension::Weekday:
+        return QLocale().dayName(key, QLocale::ShortFormat);
+    case TimerAggregation::Dimension::Hour:
+        return QString("%1:00").arg(key, 2, 10, QChar('0'));
+    }
+
+    return QString();
+}
+
+QString StatisticsPivotViewWidget::cellText(const TimerAggregation::Cell& cell) const
+{
+    if (cell.sessions == 0) {
+        return QString();
+    }
+
+    switch (static_cast<Measure>(m_measureComboBox->currentData().toInt())) {
+    case Measure::Hours:
+        return StatisticsDataManager::formatHours(cell.seconds / 3600.0);
+    case Measure::Sessions:
+        return QString::number(cell.sessions);
+    case Measure::AverageMinutes:
+        return QString("%1 min").arg(qRound(cell.seconds / 60.0 / cell.sessions));
+    }
+
+    return QString();
+}
@@ -10,9 +10,7 @@ StatisticsTimelyViewWidget::StatisticsTimelyViewWidget(QWidget* parent)
     , m_titleLabel(nullptr)
     , m_summaryLabel(nullptr)
     , m_scrollArea(nullptr)
-    , m_verticalBarsContainer(nullptr)
-    , m_verticalBarsLayout(nullptr)
-    , m_maxVerticalHours(0.0)
+    , m_chart(nullptr)
 {
     setupUi();
 }
@@ -90,31 +88,22 @@ void StatisticsTimelyViewWidget::setupUi()
         "}"
     );
 
-    m_verticalBarsContainer = new QWidget();
-    m_verticalBarsContainer->setStyleSheet("QWidget { background-color: transparent; }");
-    m_verticalBarsLayout = new QHBoxLayout(m_verticalBarsContainer);
-    m_verticalBarsLayout->setSpacing(15);
-    m_verticalBarsLayout->setContentsMargins(15, 15, 15, 15);
-    m_verticalBarsLayout->setAlignment(Qt::AlignCenter);
+    // All bars are painted by one chart widget
+    m_chart = new StatisticsChartWidget(StatisticsChartWidget::Orientation::Vertical);
+    m_chart->setStyleSheet("QWidget { background-color: transparent; }");
 
-    m_scrollArea->setWidget(m_verticalBarsContainer);
+    m_scrollArea->setWidget(m_chart);
     m_mainLayout->addWidget(m_scrollArea);
 }
 
-void StatisticsTimelyViewWidget::clearVerticalBars()
+void StatisticsTimelyViewWidget::setBars(const QList<QPair<QString, QList<StatisticsChartWidget::Segment>>>& data,
+                                         double maxHours)
 {
-    QLayoutItem* item;
-    while ((item = m_verticalBarsLayout->takeAt(0)) != nullptr) {
-        delete item->widget();
-        delete item;
+    QList<StatisticsChartWidget::Bar> bars;
+    for (const auto& barData : data) {
+        bars.append({barData.first, barData.second});
     }
-}
-
-void StatisticsTimelyViewWidget::addVerticalBar(const QString& label, double maxHours, 
-                                              const QList<StatisticsVerticalBarWidget::Segment>& segments)
-{
-    StatisticsVerticalBarWidget* barWidget = new StatisticsVerticalBarWidget(label, maxHours, segments, this);
-    m_verticalBarsLayout->addWidget(barWidget);
+    m_chart->setBars(bars, maxHours);
 }
 
 void StatisticsTimelyViewWidget::setSummaryText(const QString& text)
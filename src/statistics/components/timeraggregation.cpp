@@ -0,0 +1,111 @@
+#include "statistics/components/timeraggregation.h"
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrent>
+#include <algorithm>
+#include <limits>
+
+TimerAggregation::Result TimerAggregation::run(const TimerRecordColumns& columns, const Query& query)
+{
+    const int count = columns.size();
+    const int chunkCount = qBound(1, count / MIN_CHUNK_SIZE, QThread::idealThreadCount() * CHUNKS_PER_THREAD);
+    const int chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    // The first chunk runs here while the others run on the pool
+    QList<QFuture<Partial>> futures;
+    for (int begin = chunkSize; begin < count; begin += chunkSize) {
+        const int end = qMin(count, begin + chunkSize);
+        futures.append(QtConcurrent::run([&columns, &query, begin, end]() {
+            return reduceChunk(columns, query, begin, end);
+        }));
+    }
+
+    Partial merged = reduceChunk(columns, query, 0, qMin(count, chunkSize));
+    for (QFuture<Partial>& future : futures) {
+        const Partial partial = future.result();
+        for (auto it = partial.cbegin(); it != partial.cend(); ++it) {
+            Cell& cell = merged[it.key()];
+            cell.seconds += it.value().seconds;
+            cell.sessions += it.value().sessions;
+        }
+    }
+
+    Result result;
+    result.query = query;
+
+    QSet<int> rowKeys;
+    QSet<int> columnKeys;
+    for (auto it = merged.cbegin(); it != merged.cend(); ++it) {
+        const int row = static_cast<qint32>(it.key() >> 32);
+        const int column = static_cast<qint32>(it.key() & 0xffffffffu);
+        const Cell& cell = it.value();
+
+        result.cells.insert(qMakePair(row, column), cell);
+        for (Cell* total : {&result.rowTotals[row], &result.columnTotals[column], &result.total}) {
+            total->seconds += cell.seconds;
+            total->sessions += cell.sessions;
+        }
+        rowKeys.insert(row);
+        columnKeys.insert(column);
+    }
+
+    result.rowKeys = rowKeys.values();
+    result.columnKeys = columnKeys.values();
+    std::sort(result.rowKeys.begin(), result.rowKeys.end());
+    std::sort(result.columnKeys.begin(), result.columnKeys.end());
+
+    return result;
+}
+
+TimerAggregation::Partial TimerAggregation::reduceChunk(const TimerRecordColumns& columns, const Query& query,
+                                                        int begin, int end)
+{
+    const Filter& filter = query.filter;
+    const qint32 firstDay = filter.startDate.isValid()
+        ? static_cast<qint32>(filter.startDate.toJulianDay()) : std::numeric_limits<qint32>::min();
+    const qint32 lastDay = filter.endDate.isValid()
+        ? static_cast<qint32>(filter.endDate.toJulianDay()) : std::numeric_limits<qint32>::max();
+
+    const qint32* durations = columns.durations().constData();
+    const qint32* goalIds = columns.goalIds().constData();
+    const qint32* days = columns.localDays().constData();
+
+    Partial partial;
+    for (int i = begin; i < end; ++i) {
+        if (days[i] < firstDay || days[i] > lastDay || durations[i] < filter.minDurationSeconds) {
+            continue;
+        }
+        if (!filter.goalIds.isEmpty() && !filter.goalIds.contains(goalIds[i])) {
+            continue;
+        }
+
+        const quint64 key = (static_cast<quint64>(static_cast<quint32>(keyOf(query.rows, columns, i))) << 32) |
+                            static_cast<quint32>(keyOf(query.columns, columns, i));
+        Cell& cell = partial[key];
+        cell.seconds += durations[i];
+        cell.sessions += 1;
+    }
+
+    return partial;
+}
+
+int TimerAggregation::keyOf(Dimension dimension, const TimerRecordColumns& columns, int index)
+{
+    switch (dimension) {
+    case Dimension::None:
+        return 0;
+    case Dimension::Goal:
+        return columns.goalIds().at(index);
+    case Dimension::Year:
+        return columns.localMonths().at(index) / 12;
+    case Dimension::Month:
+        return columns.localMonths().at(index) % 12 + 1;
+    case Dimension::Weekday:
+        // Julian day 0 was a Monday
+        return columns.localDays().at(index) % 7 + 1;
+    case Dimension::Hour:
+        return columns.localSeconds().at(index) / 3600;
+    }
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include "statistics/components/timerrecordcolumns.h"
+#include <QDateTime>
+
+void TimerRecordColumns::rebuild(const QList<DatabaseManager::TimerRecord>& records)
+{
+    clear();
+    append(records);
+}
+
+void TimerRecordColumns::append(const QList<DatabaseManager::TimerRecord>& records)
+{
+    const int newSize = size() + records.size();
+    m_startTimes.reserve(newSize);
+    m_durations.reserve(newSize);
+    m_goalIds.reserve(newSize);
+    m_localDays.reserve(newSize);
+    m_localMonths.reserve(newSize);
+    m_localSeconds.reserve(newSize);
+
+    for (const auto& record : records) {
+        const QDateTime start = record.startTime.toLocalTime();
+        const QDate day = start.date();
+
+        m_startTimes.append(record.startTime.toSecsSinceEpoch());
+        m_durations.append(static_cast<qint32>(record.startTime.secsTo(record.endTime)));
+        m_goalIds.append(record.goalId);
+        m_localDays.append(static_cast<qint32>(day.toJulianDay()));
+        m_localMonths.append(day.year() * 12 + day.month() - 1);
+        m_localSeconds.append(start.time().msecsSinceStartOfDay() / 1000);
+    }
+}
+
+void TimerRecordColumns::clear()
+{
+    m_startTimes.clear();
+    m_durations.clear();
+    m_goalIds.clear();
+    m_localDays.clear();
+    m_localMonths.clear();
+    m_localSeconds.clear();
+}
@@ -2,7 +2,11 @@
 #include "statistics/components/statisticsheaderwidget.h"
 #include "statistics/components/statisticstimelyviewwidget.h"
 #include "statistics/components/statisticsgoalsviewwidget.h"
+#include "statistics/components/statisticsactivityviewwidget.h"
+#include "statistics/components/statisticspivotviewwidget.h"
+#include "statistics/components/focustrends.h"
 #include "statistics/components/statisticsdatamanager.h"
+#include "common/refreshscheduler.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QLabel>
@@ -20,7 +24,6 @@
 #include <QLinearGradient>
 #include <QMouseEvent>
 #include <QPropertyAnimation>
-#include <QGraphicsDropShadowEffect>
 #include <QHelpEvent>
 #include <cmath>
 #include <QGroupBox>
@@ -30,289 +33,14 @@
 #include <QAction>
 #include "database/databasemanager.h"
 
-// StatisticsBarWidget implementation
-StatisticsBarWidget::StatisticsBarWidget(const QString& label, double hours, double maxHours,
-                                       const QColor& color, QWidget* parent)
-    : QWidget(parent)
-    , m_label(label)
-    , m_hours(hours)
-    , m_maxHours(maxHours)
-    , m_barColor(color)
-{
-    setFixedHeight(BAR_HEIGHT + MARGIN * 2);
-    setMinimumWidth(300);
-
-    // Apply modern styling with rounded corners
-    setStyleSheet(
-        "StatisticsBarWidget {"
-        "   background-color: #ffffff;"
-        "   border-radius: 12px;"
-        "   border: 1px solid #e0e0e0;"
-        "}"
-        "StatisticsBarWidget:hover {"
-        "   background-color: #fefefe;"
-        "   border: 1px solid #d0d0d0;"
-        "}"
-    );
-
-    // Add subtle shadow effect
-    QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect(this);
-    shadow->setBlurRadius(8);
-    shadow->setXOffset(0);
-    shadow->setYOffset(2);
-    shadow->setColor(QColor(0, 0, 0, 20));
-    setGraphicsEffect(shadow);
-}
-
-void StatisticsBarWidget::paintEvent(QPaintEvent* event) {
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    QRect rect = this->rect();
-
-    // Calculate areas
-    QRect labelRect(0, 0, LABEL_WIDTH, rect.height());
-    QRect barRect(LABEL_WIDTH + MARGIN, MARGIN,
-                  rect.width() - LABEL_WIDTH - 2 * MARGIN,
-                  rect.height() - 2 * MARGIN);
-
-    // Draw label
-    painter.setPen(QPen(QColor("#2c3e50"), 1));
-    QFont labelFont = painter.font();
-    labelFont.setPointSize(11);
-    labelFont.setWeight(QFont::Medium);
-    painter.setFont(labelFont);
-    painter.drawText(labelRect, Qt::AlignLeft | Qt::AlignVCenter, m_label);
-
-    // Draw bar background
-    painter.setPen(QPen(QColor("#e0e0e0"), 1));
-    painter.setBrush(QBrush(QColor("#f8f9fa")));
-    painter.drawRoundedRect(barRect, 4, 4);
-
-    // Draw actual bar if there's data
-    if (m_hours > 0 && m_maxHours > 0) {
-        double fillRatio = m_hours / m_maxHours;
-        int fillWidth = static_cast<int>(fillRatio * barRect.width());
-
-        QRect fillRect(barRect.left(), barRect.top(), fillWidth, barRect.height());
-
-        painter.setPen(QPen(m_barColor.darker(110), 1));
-        painter.setBrush(QBrush(m_barColor));
-        painter.drawRoundedRect(fillRect, 4, 4);
-
-        // Draw time text with h/m units
-        painter.setPen(QPen(QColor("#ffffff")));
-        QFont timeFont = painter.font();
-        timeFont.setPointSize(10);
-        timeFont.setWeight(QFont::Bold);
-        painter.setFont(timeFont);
-
-        // Format time text with units
-        QString timeText;
-        if (m_hours < 1.0) {
-            int minutes = static_cast<int>(m_hours * 60);
-            timeText = QString("%1m").arg(minutes);
-        } else if (m_hours < 10.0) {
-            timeText = QString("%1h").arg(QString::number(m_hours, 'f', 1));
-        } else {
-            timeText = QString("%1h").arg(static_cast<int>(m_hours));
-        }
-
-        // Only draw text if there's enough space
-        QFontMetrics fm(timeFont);
-        QRect textBounds = fm.boundingRect(timeText);
-        if (fillWidth > textBounds.width() + 10) {
-            // Draw text with shadow for better readability
-            painter.setPen(QPen(QColor("#000000"), 1));
-            painter.drawText(fillRect.adjusted(1, 1, 1, 1), Qt::AlignCenter, timeText);
-            painter.setPen(QPen(QColor("#ffffff"), 1));
-            painter.drawText(fillRect, Qt::AlignCenter, timeText);
-        }
-    }
-}
-
-// StatisticsVerticalBarWidget implementation
-StatisticsVerticalBarWidget::StatisticsVerticalBarWidget(
-    const QString& dateLabel,
-    double maxHours,
-    const QList<Segment>& segments,
-    QWidget* parent)
-    : QWidget(parent)
-    , m_dateLabel(dateLabel)
-    , m_segments(segments)
-    , m_maxHours(maxHours > 0 ? maxHours : 1.0)
-{
-    setFixedWidth(BAR_WIDTH + MARGIN * 2);
-    setToolTip(QString("Click to see details"));
-
-    // Apply modern styling with rounded corners
-    setStyleSheet(
-        "StatisticsVerticalBarWidget {"
-        "   background-color: #ffffff;"
-        "   border-radius: 12px;"
-        "   border: 1px solid #e0e0e0;"
-        "}"
-        "StatisticsVerticalBarWidget:hover {"
-        "   background-color: #fefefe;"
-        "   border: 1px solid #FF6B6B;"
-        "   border-width: 2px;"
-        "}"
-    );
-
-    // Add subtle shadow effect
-    QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect(this);
-    shadow->setBlurRadius(6);
-    shadow->setXOffset(0);
-    shadow->setYOffset(2);
-    shadow->setColor(QColor(0, 0, 0, 15));
-    setGraphicsEffect(shadow);
-}
-
-void StatisticsVerticalBarWidget::paintEvent(QPaintEvent* event) {
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    QRect rect = this->rect();
-
-    // Reserve space at the top for total time display
-    const int TOTAL_TIME_HEIGHT = 20;
-
-    // Calculate areas with much larger bar area and smaller label area
-    QRect totalTimeRect(0, 0, rect.width(), TOTAL_TIME_HEIGHT);
-    QRect labelRect(0, rect.height() - 30, rect.width(), 30); // Reduced label height
-    QRect barRect(MARGIN, TOTAL_TIME_HEIGHT + MARGIN, rect.width() - 2 * MARGIN,
-                  rect.height() - 30 - TOTAL_TIME_HEIGHT - 3 * MARGIN); // Much larger bar area
-
-    // Draw date label at bottom
-    painter.setPen(QPen(QColor("#2c3e50"), 1));
-    QFont labelFont = painter.font();
-    labelFont.setPointSize(9); // Smaller font for more compact label
-    labelFont.setWeight(QFont::Medium);
-    painter.setFont(labelFont);
-    painter.drawText(labelRect, Qt::AlignCenter, m_dateLabel);
-
-    // Calculate total hours for this bar
-    double totalHours = 0.0;
-    for (const auto& segment : m_segments) {
-        if (segment.hours > 0) {
-            totalHours += segment.hours;
-        }
-    }
-
-    // Draw total time at the top if there are segments
-    if (totalHours > 0) {
-        painter.setPen(QPen(QColor("#2c3e50"), 1));
-        QFont totalFont = painter.font();
-        totalFont.setPointSize(11);
-        totalFont.setWeight(QFont::Bold);
-        painter.setFont(totalFont);
-
-        // Format total time inline
-        QString totalText;
-        if (totalHours < 1.0) {
-            int minutes = static_cast<int>(totalHours * 60);
-            totalText = QString("%1m").arg(minutes);
-        } else if (totalHours < 10.0) {
-            totalText = QString("%1h").arg(QString::number(totalHours, 'f', 1));
-        } else {
-            totalText = QString("%1h").arg(static_cast<int>(totalHours));
-        }
-
-        painter.drawText(totalTimeRect, Qt::AlignCenter, totalText);
-    }
-
-    // Draw bar background
-    painter.setPen(QPen(QColor("#e0e0e0"), 1));
-    painter.setBrush(QBrush(QColor("#f8f9fa")));
-    painter.drawRoundedRect(barRect, 4, 4);
-
-    // Only draw segments if we have data
-    if (m_segments.isEmpty() || totalHours <= 0) {
-        return;
-    }
-
-    double scaledTotalHours = sqrt(totalHours);
-    double scaledMaxHours = sqrt(m_maxHours);
-
-    double barFillRatio = scaledTotalHours / scaledMaxHours;
-    double usedBarHeight = barFillRatio * barRect.height();
-
-    double currentY = barRect.bottom();
-
-    for (const auto& segment : m_segments) {
-        if (segment.hours <= 0) continue;
-
-        double proportion = segment.hours / totalHours;
-        double segmentHeight = proportion * usedBarHeight;
-        segmentHeight = qMax(segmentHeight, 3.0);
-
-        QRect segmentRect(barRect.left(),
-                         currentY - segmentHeight,
-                         barRect.width(),
-                         segmentHeight);
-
-        painter.setPen(QPen(segment.color.darker(110), 1));
-        painter.setBrush(QBrush(segment.color));
-        painter.drawRoundedRect(segmentRect, 2, 2);
-
-        currentY -= segmentHeight;
-    }
-}
-
-bool StatisticsVerticalBarWidget::event(QEvent* event) {
-    if (event->type() == QEvent::ToolTip) {
-        if (!m_segments.isEmpty()) {
-            QString tooltip = QString("<b>%1</b><br/>").arg(m_dateLabel);
-            double totalHours = 0;
-
-            for (const auto& segment : m_segments) {
-                totalHours += segment.hours;
-                tooltip += QString("• %1: %2h<br/>")
-                          .arg(segment.goalTitle)
-                          .arg(segment.hours, 0, 'f', 1);
-            }
-
-            tooltip += QString("<b>Total: %1h</b>").arg(totalHours, 0, 'f', 1);
-            QToolTip::showText(static_cast<QHelpEvent*>(event)->globalPos(), tooltip);
-        }
-        return true;
-    }
-    return QWidget::event(event);
-}
-
-QSize StatisticsVerticalBarWidget::sizeHint() const {
-    return QSize(BAR_WIDTH, 300);
-}
-
-int StatisticsVerticalBarWidget::getSegmentIndexAtPosition(const QPoint& pos) const {
-    QRect rect = this->rect().adjusted(MARGIN, MARGIN, -MARGIN, -MARGIN);
-    QRect barArea(rect.left() + 10, rect.top() + 10,
-                  BAR_WIDTH - 20, rect.height() - LABEL_HEIGHT - 20);
-
-    if (!barArea.contains(pos)) {
-        return -1;
-    }
-
-    int relativeY = barArea.bottom() - pos.y();
-    double ratio = static_cast<double>(relativeY) / barArea.height();
-    double currentRatio = 0;
-
-    for (int i = 0; i < m_segments.size(); ++i) {
-        double segmentRatio = m_segments[i].hours / m_maxHours;
-        if (ratio <= currentRatio + segmentRatio) {
-            return i;
-        }
-        currentRatio += segmentRatio;
-    }
-
-    return -1;
-}
-
 // StatisticsWidget implementation
 StatisticsWidget::StatisticsWidget(QWidget* parent) : QWidget(parent) {
     setupUi();
     connectSignals();
-    refreshFromDatabase();
+
+    // Answered again after every refresh that read new sessions; the first
+    // refresh runs when the page is first shown
+    m_dataManager->runQuery(m_pivotViewWidget->query());
 }
 
 void StatisticsWidget::setupUi() {
@@ -365,6 +93,14 @@ void StatisticsWidget::setupUi() {
     // Create goals view widget - now uses custom paintEvent for rounded corners
     m_goalsViewWidget = new StatisticsGoalsViewWidget(this);
     m_mainLayout->addWidget(m_goalsViewWidget);
+
+    // Year-long heatmap, fed from the daily rollup rather than the session index
+    m_activityViewWidget = new StatisticsActivityViewWidget(this);
+    m_mainLayout->addWidget(m_activityViewWidget);
+
+    // Ad-hoc questions over every session, answered from the columnar snapshot
+    m_pivotViewWidget = new StatisticsPivotViewWidget(this);
+    m_mainLayout->addWidget(m_pivotViewWidget);
 }
 
 void StatisticsWidget::connectSignals() {
@@ -387,10 +123,40 @@ void StatisticsWidget::connectSignals() {
             this, &StatisticsWidget::onGoalDataLoaded);
     connect(m_dataManager, &StatisticsDataManager::dataRefreshed,
             this, &StatisticsWidget::updateStatistics);
+    connect(m_dataManager, &StatisticsDataManager::busyChanged,
+            m_headerWidget, &StatisticsHeaderWidget::setBusy);
+    connect(m_dataManager, &StatisticsDataManager::dailyTotalsLoaded,
+            m_activityViewWidget, &StatisticsActivityViewWidget::setDailyTotals);
+    connect(m_dataManager, &StatisticsDataManager::queryFinished,
+            m_pivotViewWidget, &StatisticsPivotViewWidget::setResult);
+    connect(m_pivotViewWidget, &StatisticsPivotViewWidget::queryChanged,
+            m_dataManager, &StatisticsDataManager::runQuery);
+
+    connect(&DatabaseManager::instance(), &DatabaseManager::dataChanged,
+            this, &StatisticsWidget::onDataChanged);
+    connect(&FocusTrends::instance(), &FocusTrends::loaded,
+            this, &StatisticsWidget::updateTrends);
+
+    RefreshScheduler::instance().addPage(this, [this]() {
+        refreshFromDatabase();
+    });
 }
 
 void StatisticsWidget::refreshFromDatabase() {
     m_dataManager->refreshFromDatabase();
+    m_dataManager->loadDailyTotals();
+    updateTrends();
+}
+
+void StatisticsWidget::onDataChanged(const DatabaseManager::ChangeSet& changes) {
+    // Noted even while hidden, so the refresh on switching here knows whether to rebuild
+    m_dataManager->noteChanges(changes);
+
+    // Todos are not charted; hidden pages are refreshed when switched to
+    if (changes.affects(DatabaseManager::Entity::TimerRecord) ||
+        changes.affects(DatabaseManager::Entity::Goal)) {
+        RefreshScheduler::instance().invalidate(this);
+    }
 }
 
 void StatisticsWidget::onTimeRangeChanged() {
@@ -402,57 +168,35 @@ void StatisticsWidget::onRefreshClicked() {
 }
 
 void StatisticsWidget::onPreviousPeriod() {
-    QString rangeType = m_headerWidget->getCurrentTimeRange();
-    QDate currentDate = m_headerWidget->getCurrentReferenceDate();
-
-    if (rangeType == "daily") {
-        currentDate = currentDate.addDays(-1);
-    } else if (rangeType == "weekly") {
-        currentDate = currentDate.addDays(-7);
-    } else if (rangeType == "monthly") {
-        currentDate = currentDate.addMonths(-1);
-    }
-
-    m_headerWidget->setCurrentReferenceDate(currentDate);
+    m_headerWidget->setCurrentPeriod(m_headerWidget->getCurrentPeriod().shifted(-1));
     m_headerWidget->updateNavigationButtons();
     updateStatistics();
 }
 
 void StatisticsWidget::onNextPeriod() {
-    QString rangeType = m_headerWidget->getCurrentTimeRange();
-    QDate currentDate = m_headerWidget->getCurrentReferenceDate();
-
-    if (rangeType == "daily") {
-        currentDate = currentDate.addDays(1);
-    } else if (rangeType == "weekly") {
-        currentDate = currentDate.addDays(7);
-    } else if (rangeType == "monthly") {
-        currentDate = currentDate.addMonths(1);
-    }
-
-    m_headerWidget->setCurrentReferenceDate(currentDate);
+    m_headerWidget->setCurrentPeriod(m_headerWidget->getCurrentPeriod().shifted(1));
     m_headerWidget->updateNavigationButtons();
     updateStatistics();
 }
 
 void StatisticsWidget::onTodayClicked() {
-    m_headerWidget->setCurrentReferenceDate(QDate::currentDate());
+    const StatisticsPeriod period = m_headerWidget->getCurrentPeriod();
+    const QDate today = QDate::currentDate();
+
+    // Custom periods keep their length and end today
+    if (period.rangeType == StatisticsRangeType::Custom) {
+        m_headerWidget->setCurrentPeriod(StatisticsPeriod::custom(today.addDays(1 - period.dayCount()), today));
+    } else {
+        m_headerWidget->setCurrentPeriod(StatisticsPeriod::containing(period.rangeType, today));
+    }
     m_headerWidget->updateNavigationButtons();
     updateStatistics();
 }
 
-void StatisticsWidget::onTimeBasedDataLoaded(const QList<QPair<QString, QList<StatisticsVerticalBarWidget::Segment>>>& data,
+void StatisticsWidget::onTimeBasedDataLoaded(const QList<QPair<QString, QList<StatisticsChartWidget::Segment>>>& data,
                                            const QString& summaryText) {
-    // Clear existing bars
-    m_timelyViewWidget->clearVerticalBars();
-
-    // Set max hours for scaling
-    m_timelyViewWidget->setMaxVerticalHours(m_dataManager->getMaxVerticalHours());
-
-    // Add new bars
-    for (const auto& barData : data) {
-        m_timelyViewWidget->addVerticalBar(barData.first, m_dataManager->getMaxVerticalHours(), barData.second);
-    }
+    // Replace the bars in place, scaled to the tallest one
+    m_timelyViewWidget->setBars(data, m_dataManager->getMaxVerticalHours());
 
     // Update summary
     m_timelyViewWidget->setSummaryText(summaryText);
@@ -460,30 +204,23 @@ void StatisticsWidget::onTimeBasedDataLoaded(const QList<QPair<QString, QList<St
 
 void StatisticsWidget::onGoalDataLoaded(const QList<QPair<QString, QPair<double, QColor>>>& data,
                                       const QString& summaryText) {
-    // Clear existing bars
-    m_goalsViewWidget->clearBars();
-
-    // Set max hours for scaling
-    m_goalsViewWidget->setMaxHours(m_dataManager->getMaxHours());
-
-    // Add new bars
-    for (const auto& barData : data) {
-        m_goalsViewWidget->addBar(barData.first, barData.second.first, barData.second.second);
-    }
+    // Replace the bars in place, scaled to the longest one
+    m_goalsViewWidget->setBars(data, m_dataManager->getMaxHours());
 
     // Update summary
     m_goalsViewWidget->setSummaryText(summaryText);
 }
 
-void StatisticsWidget::updateStatistics() {
-    QString rangeType = m_headerWidget->getCurrentTimeRange();
-    QDate referenceDate = m_headerWidget->getCurrentReferenceDate();
+void StatisticsWidget::updateTrends() {
+    // Kept up to date as sessions are stored; reading them costs nothing
+    m_activityViewWidget->setTrends(FocusTrends::instance().summary());
+}
 
+void StatisticsWidget::updateStatistics() {
     // Update header
     m_headerWidget->updatePeriodLabel();
     m_headerWidget->updateNavigationButtons();
 
-    // Load data through data manager
-    m_dataManager->loadTimeBasedStatistics(rangeType, referenceDate);
-    m_dataManager->loadGoalStatistics(rangeType, referenceDate);
+    // Load data through data manager; the views update when it is delivered
+    m_dataManager->loadStatistics(m_headerWidget->getCurrentPeriod());
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "timer/compacttimerwidget.h"
 #include "database/databasemanager.h"
+#include "statistics/components/focustrends.h"
 #include "settings/settingsdialog.h"
 #include <QHBoxLayout>
 #include <QLabel>
@@ -312,7 +313,10 @@ void CompactTimerWidget::saveToDatabase(const TimerCore::SessionData& data) {
     record.endTime = data.pauseStartTime;
 
     DatabaseManager& dbManager = DatabaseManager::instance();
-    dbManager.addTimerRecord(record);
+    if (dbManager.addTimerRecord(record)) {
+        // Streaks and averages take the new session in without rereading history
+        FocusTrends::instance().recordSession(record);
+    }
 }
 
 
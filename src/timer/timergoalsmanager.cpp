@@ -108,8 +108,12 @@ void TimerGoalsManager::updateTodayTimeSpent() {
 
     DatabaseManager& db = DatabaseManager::instance();
 
-    // Get today's total time in seconds
-    int totalSeconds = db.getGoalTimeSpent(-1);
+    // Get today's total time in seconds across all goals
+    const QDate today = QDate::currentDate();
+    int totalSeconds = 0;
+    for (const auto& time : db.getTimePerGoalInPeriod(today, today)) {
+        totalSeconds += time.seconds;
+    }
 
     // Convert to hours and minutes
     int hours = totalSeconds / 3600;